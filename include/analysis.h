@@ -0,0 +1,38 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include "process.h"
+
+// Testes analíticos de escalonabilidade para tarefas periódicas, sobre
+// burst_time (C), period (T) e deadline - arrival_time (D, limitado a T:
+// o simulador dá o job por perdido na liberação seguinte).
+//  - RM: limites de Liu & Layland e hiperbólico (suficientes, só D = T) e
+//    análise exata do tempo de resposta, com a prioridade do simulador
+//    (menor período, empates pelo menor índice)
+//  - EDF: U <= 1 (exato com D = T) ou análise da procura de processador
+//    com o algoritmo QPA (D < T)
+// Os testes exatos supõem libertação síncrona (instante crítico): com
+// chegadas diferentes um resultado negativo passa a inconclusivo, e tarefas
+// sem período (libertadas uma única vez) tornam inconclusivo um positivo.
+typedef enum {
+    FEASIBLE,
+    INFEASIBLE,
+    INCONCLUSIVE,
+    NOT_APPLICABLE
+} Feasibility;
+
+typedef struct {
+    int tasks;              // tarefas periódicas com burst > 0
+    double utilization;
+    Feasibility utilization_bound;  // RM: Liu & Layland; EDF: U <= 1 (D = T)
+    Feasibility hyperbolic;         // só RM
+    Feasibility exact;              // RM: tempo de resposta; EDF: procura de processador
+    Feasibility verdict;
+} SchedAnalysis;
+
+SchedAnalysis analyze_rm(const ProcessQueue* queue);
+SchedAnalysis analyze_edf(const ProcessQueue* queue);
+
+const char* feasibility_name(Feasibility f);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Arena (bump allocator) para o estado de cada execução: tabelas de
+// processos, filas de prontos e vetores auxiliares saem de um bloco mapeado
+// com mmap e são libertados de uma vez ao voltar a uma marca. As marcas
+// encaixam (pilha), por isso uma execução pode correr dentro de outra.
+// Quando um bloco esgota é mapeado outro; ao voltar à arena vazia os blocos
+// extra são substituídos por um único com o pico de uso, e as execuções
+// seguintes reutilizam memória já tocada sem chamadas ao alocador.
+// Não é thread-safe: cada thread usa a sua (thread_arena).
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock* block;  // bloco atual (o último da cadeia)
+    size_t total;       // bytes ocupados desde a arena vazia, com alinhamento
+    size_t peak;        // maior total desde a criação
+    int grown;          // foram precisos blocos extra desde a última consolidação
+    int huge_pages;
+} Arena;
+
+// Posição a que arena_release volta
+typedef struct {
+    int block;          // índice do bloco na cadeia
+    size_t used;
+    size_t total;
+} ArenaMark;
+
+// Com huge_pages os blocos são múltiplos de 2 MiB e pedidos com
+// MAP_HUGETLB; sem páginas reservadas no sistema recorre a madvise
+// (transparent huge pages)
+Arena* create_arena(size_t capacity, int huge_pages);
+void destroy_arena(Arena* arena);
+
+// Memória alinhada a ARENA_ALIGN (ou a align, potência de 2), não inicializada
+#define ARENA_ALIGN 16
+void* arena_alloc(Arena* arena, size_t size);
+void* arena_alloc_aligned(Arena* arena, size_t size, size_t align);
+
+// Realocação: cresce no lugar se ptr for a última alocação e houver espaço,
+// senão copia para um bloco novo (o antigo só volta com a marca)
+void* arena_grow(Arena* arena, void* ptr, size_t old_size, size_t new_size);
+
+ArenaMark arena_mark(const Arena* arena);
+void arena_release(Arena* arena, ArenaMark mark);
+
+// Arena da thread atual, criada no primeiro uso e destruída quando a thread
+// termina. arena_huge_pages vale para as arenas criadas depois de alterado.
+extern int arena_huge_pages;
+Arena* thread_arena(void);
+
+#endif
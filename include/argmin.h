@@ -0,0 +1,12 @@
+#ifndef ARGMIN_H
+#define ARGMIN_H
+
+// Argmin com máscara sobre colunas int32 (ProcessTable): devolve o menor i
+// com key[i] mínimo entre os elegíveis, isto é, com gate[i] >= gate_min e
+// arrival[i] <= time; -1 se nenhum for elegível. Em caso de empate ganha o
+// menor índice, como nos heaps e nas pesquisas lineares.
+// A implementação (AVX2, SSE4.1 ou escalar) é escolhida em tempo de execução.
+int argmin_masked(const int* key, const int* gate, int gate_min,
+                  const int* arrival, int time, int n);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include "scheduler.h"
+
+// Medição do desempenho dos escalonadores: cada algoritmo corre no modo
+// estático sobre cargas sintéticas de tamanho e horizonte crescentes, sem
+// saída dos escalonadores, e cada execução é medida em tempo de parede,
+// ticks simulados e decisões de escalonamento por segundo e pico de RSS.
+typedef struct {
+    SchedulingAlgorithm* algos;
+    int num_algos;
+    int* sizes;         // número de processos de cada carga
+    int num_sizes;
+    int* horizons;      // tempo_total do modo estático
+    int num_horizons;
+    int quantum;
+    int seed;
+    double mean_burst;  // média dos bursts da carga (exponencial, >= 1 tick)
+} BenchConfig;
+
+// Média dos bursts por omissão: o gerador dá quase sempre bursts de 1 tick,
+// com os quais nem quanta nem fatias chegam a expirar
+#define BENCH_BURST 10.0
+
+// Escreve a tabela na saída e, com csv != NULL, uma linha CSV por execução.
+// Devolve o número de execuções medidas.
+int run_bench(const BenchConfig* config, FILE* csv);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "periodic.h"
+
+// Checkpoints das simulações RM/EDF do modo STATIC: o estado completo
+// (instante, relógio, tempo de CPU acumulado, tempo restante, próxima
+// liberação e perdas de cada tarefa, gerador aleatório) num ficheiro binário
+// compacto. A simulação retomada continua exatamente onde parou, por isso
+// prolongar o horizonte custa só o tempo acrescentado.
+typedef struct {
+    const char* save_path;      // grava o estado no fim (NULL = não grava)
+    const char* resume_path;    // retoma deste ficheiro (NULL = desde o instante 0)
+    long long stop_at;          // pára neste instante (0 = no horizonte)
+} CheckpointConfig;
+
+// Rejeitam ficheiros de outra carga ou de outro algoritmo.
+// Devolvem 0, ou -1 em caso de erro.
+int save_checkpoint(const char* path, const ProcessTable* table, int use_deadline,
+                    const PeriodicResume* state);
+int load_checkpoint(const char* path, ProcessTable* table, int use_deadline,
+                    PeriodicResume* state);
+
+// SIGINT/SIGTERM pedem a paragem da simulação (periodic_stop_requested), que
+// depois grava o checkpoint; um segundo sinal termina o programa
+void install_checkpoint_signals(void);
+
+#endif
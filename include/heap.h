@@ -0,0 +1,42 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include "arena.h"
+
+// Heap binário mínimo indexado, usado como fila de prontos.
+// Cada elemento é um índice de processo com uma chave; a capacidade cresce
+// quando é inserido um índice maior. Em caso de empate ganha o menor índice,
+// como nas pesquisas lineares. A memória vem da arena e é libertada com ela.
+typedef struct {
+    long long key;
+    int id;
+} HeapNode;
+
+typedef struct {
+    HeapNode* nodes;
+    int* pos;       // posição de cada id em nodes, -1 se não estiver no heap
+    int size;
+    int capacity;
+    Arena* arena;
+} ReadyHeap;
+
+ReadyHeap* create_ready_heap(Arena* arena, int capacity);
+void heap_push(ReadyHeap* heap, int id, long long key);
+int heap_pop(ReadyHeap* heap);
+void heap_update(ReadyHeap* heap, int id, long long key);
+void heap_remove(ReadyHeap* heap, int id);
+
+// Topo do heap (-1 se vazio) e respetiva chave
+static inline int heap_peek(const ReadyHeap* heap) {
+    return heap->size ? heap->nodes[0].id : -1;
+}
+
+static inline long long heap_top_key(const ReadyHeap* heap) {
+    return heap->nodes[0].key;
+}
+
+static inline int heap_contains(const ReadyHeap* heap, int id) {
+    return id < heap->capacity && heap->pos[id] >= 0;
+}
+
+#endif
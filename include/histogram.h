@@ -0,0 +1,68 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdint.h>
+
+// Histograma de memória fixa com baldes logarítmicos (estilo HDR): valores
+// até 2^HIST_SUB_BITS são exatos e a partir daí cada potência de 2 tem
+// 2^(HIST_SUB_BITS - 1) baldes, pelo que os percentis têm erro relativo
+// inferior a 1/64. Registar é O(1); dois histogramas juntam-se somando os
+// baldes (execuções em paralelo, partições). Os valores negativos (atraso
+// de um job que acabou antes do deadline) ficam em baldes espelhados, e os
+// módulos a partir de 2^32 contam no último balde (o max é exato).
+#define HIST_SUB_BITS 7
+#define HIST_HALF (1 << (HIST_SUB_BITS - 1))
+#define HIST_BUCKETS ((32 - HIST_SUB_BITS + 2) * HIST_HALF)   // módulos < 2^32
+
+typedef struct {
+    // [0, HIST_BUCKETS): negativos, do maior módulo para o menor;
+    // [HIST_BUCKETS, 2 * HIST_BUCKETS): zero e positivos
+    uint64_t counts[2 * HIST_BUCKETS];
+    int lowest, highest;    // baldes usados (lowest > highest se vazio)
+    uint64_t total;
+    long long sum;
+    long long min, max;
+} Histogram;
+
+typedef struct {
+    long long count;
+    long long p50, p90, p99, p999, max;
+} Percentiles;
+
+void hist_init(Histogram* h);
+
+// Balde do módulo v >= 0
+static inline int hist_bucket(unsigned long long v) {
+    if (v >= (1ULL << 32)) v = (1ULL << 32) - 1;
+    if (v < 2 * HIST_HALF) return (int)v;
+    int shift = 63 - __builtin_clzll(v) - HIST_SUB_BITS + 1;
+    return shift * HIST_HALF + (int)(v >> shift);
+}
+
+static inline void hist_record(Histogram* h, long long value) {
+    int i = value >= 0 ? HIST_BUCKETS + hist_bucket((unsigned long long)value)
+                       : HIST_BUCKETS - 1 - hist_bucket(-(unsigned long long)value);
+    h->counts[i]++;
+    if (i < h->lowest) h->lowest = i;
+    if (i > h->highest) h->highest = i;
+    if (value < h->min) h->min = value;
+    if (value > h->max) h->max = value;
+    h->total++;
+    h->sum += value;
+}
+
+// into += from
+void hist_merge(Histogram* into, const Histogram* from);
+// dst = src, copiando só os baldes usados: dst tem de ter começado vazio e
+// src ter sempre um superconjunto dos baldes que dst já teve
+void hist_copy(Histogram* dst, const Histogram* src);
+// Soma times vezes o que h registou desde since (extrapolação de ciclos)
+void hist_repeat_since(Histogram* h, const Histogram* since, long long times);
+
+// Percentis pelo limite superior do balde (limitado ao max)
+Percentiles hist_percentiles(const Histogram* h);
+
+// Linha "<label> p50/p90/p99/p99.9/max: ..." (nada se estiver vazio)
+void log_percentiles(const char* label, const Percentiles* p);
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <stdint.h>
+
+// Instrumentação dos ciclos quentes (scheduler.c, periodic.c e geradores de
+// utils.c). Só existe quando compilado com -DPROBSCHED_INSTRUMENT
+// (make INSTRUMENT=1); sem a flag as macros não geram código.
+//
+// Cada ciclo marca as fronteiras entre fases com INSTR_LAP, que soma à fase
+// o tempo desde a marca anterior (rdtsc em x86, senão clock_gettime em ns).
+// Os contadores e os tempos são por thread e são escritos como um bloco JSON
+// no fim de cada execução (INSTR_REPORT), com verbosidade >= SUMMARY. No
+// modo STREAM a geração acontece dentro da fase de chegadas e conta nas duas.
+typedef enum {
+    PHASE_RELEASE,      // chegadas / liberações de jobs
+    PHASE_SELECT,       // escolha do próximo processo
+    PHASE_AGING,
+    PHASE_ACCOUNT,      // execução, tempos e conclusões
+    PHASE_OUTPUT,       // LOG_JOB e linha temporal
+    PHASE_GENERATE,     // geradores de variáveis aleatórias
+    PHASE_COUNT
+} InstrumentPhase;
+
+typedef enum {
+    COUNT_SCANS,            // passagens lineares pela tabela de processos
+    COUNT_SELECT_ITERATIONS,// elementos examinados pela escolha do próximo processo
+    COUNT_PREEMPTIONS,      // job interrompido sem ter terminado
+    COUNT_CONTEXT_SWITCHES, // despacho de um job diferente do anterior
+    COUNT_IDLE_TICKS,
+    COUNT_RNG_DRAWS,
+    COUNTER_COUNT
+} InstrumentCounter;
+
+#ifdef PROBSCHED_INSTRUMENT
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define INSTR_CLOCK_UNIT "tsc"
+static inline uint64_t instr_clock(void) {
+    return __rdtsc();
+}
+#else
+#include <time.h>
+#define INSTR_CLOCK_UNIT "ns"
+static inline uint64_t instr_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+typedef struct {
+    uint64_t cycles[PHASE_COUNT];
+    uint64_t laps[PHASE_COUNT];
+    uint64_t counters[COUNTER_COUNT];
+} Instrumentation;
+
+extern _Thread_local Instrumentation instrumentation;
+
+void instrument_report(const char* run);
+// Soma à thread atual as contagens de outra (partições corridas no pool)
+void instrument_merge(const Instrumentation* from);
+
+#define INSTR_START(t) uint64_t t = instr_clock()
+#define INSTR_LAP(t, phase) do {                                  \
+        uint64_t instr_now_ = instr_clock();                      \
+        instrumentation.cycles[phase] += instr_now_ - (t);        \
+        instrumentation.laps[phase]++;                            \
+        (t) = instr_now_;                                         \
+    } while (0)
+#define INSTR_COUNT(counter, n) (instrumentation.counters[counter] += (uint64_t)(n))
+#define INSTR_REPORT(run) instrument_report(run)
+
+#else
+
+#define INSTR_START(t) do { } while (0)
+#define INSTR_LAP(t, phase) do { } while (0)
+#define INSTR_COUNT(counter, n) do { } while (0)
+#define INSTR_REPORT(run) do { } while (0)
+
+#endif
+
+#endif
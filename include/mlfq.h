@@ -0,0 +1,44 @@
+#ifndef MLFQ_H
+#define MLFQ_H
+
+#include "arena.h"
+#include "ring.h"
+
+// Filas do MLFQ (multi-level feedback queue): uma FIFO de índices por nível,
+// com o nível 0 como o mais prioritário, e um bitmap com os níveis não
+// vazios. Cada FIFO é um anel (ring.h); o nível 0 é uma sequência de anéis,
+// para que o boost (todos os jobs prontos para o nível 0) só mova anéis
+// inteiros: os dos níveis de baixo passam, por ordem, para o fim do nível 0
+// e são substituídos por anéis vazios, em O(níveis) seja qual for o número
+// de jobs. Inserir e retirar custam O(1) amortizado. A memória vem da arena
+// e é libertada com ela.
+#define MLFQ_MAX_LEVELS 16
+
+typedef struct {
+    RingQueue** rings;          // todos os anéis, por índice
+    int num_rings;
+    int rings_capacity;
+    RingQueue* top;             // índices dos anéis do nível 0, por ordem
+    RingQueue* spare;           // índices dos anéis vazios por reutilizar
+    int level[MLFQ_MAX_LEVELS]; // anel onde entra cada nível (no 0, o último de top)
+    int size[MLFQ_MAX_LEVELS];
+    unsigned bitmap;            // bit l ligado se o nível l não está vazio
+    int levels;
+    Arena* arena;
+} MlfqQueues;
+
+MlfqQueues* create_mlfq_queues(Arena* arena, int levels, int capacity);
+void mlfq_boost(MlfqQueues* q);
+
+// Insere id no fim do nível (0 <= level < levels)
+static inline void mlfq_push(MlfqQueues* q, int id, int level) {
+    ring_push(q->rings[q->level[level]], id);
+    q->size[level]++;
+    q->bitmap |= 1u << level;
+}
+
+// Retira a cabeça do nível mais prioritário não vazio e devolve o seu nível
+// em *level (-1 se vazias)
+int mlfq_pop(MlfqQueues* q, int* level);
+
+#endif
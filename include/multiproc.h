@@ -0,0 +1,31 @@
+#ifndef MULTIPROC_H
+#define MULTIPROC_H
+
+#include "scheduler.h"
+
+// Escalonamento de tarefas periódicas (RM/EDF) em m processadores:
+//  - global: uma só fila, correm em cada instante os m jobs de maior
+//    prioridade (RM global = prioridade fixa global, EDF global)
+//  - particionado: cada tarefa é atribuída a um processador por bin packing
+//    da utilização (first-fit ou worst-fit, por utilização decrescente) e
+//    cada partição é simulada como um uniprocessador na sua própria thread
+typedef enum {
+    MP_GLOBAL,
+    MP_FIRST_FIT,
+    MP_WORST_FIT
+} MultiprocPolicy;
+
+typedef struct {
+    int cpus;
+    MultiprocPolicy policy;
+    int threads;    // threads para as partições, 0 = número de CPUs disponíveis
+} MultiprocConfig;
+
+// Só RATE_MONOTONIC e EDF; a utilização é relativa aos m processadores
+SchedulerStats run_multiprocessor(ProcessQueue* queue, SchedulingAlgorithm algo,
+                                  long long tempo_total, const MultiprocConfig* config);
+
+// "GLOBAL", "FF" ou "WF" (-1 se desconhecida)
+int parse_multiproc_policy(const char* str);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+
+// Níveis de verbosidade da saída dos escalonadores
+typedef enum {
+    VERBOSITY_QUIET,     // nada (modo SWEEP)
+    VERBOSITY_SUMMARY,   // cabeçalhos e métricas finais
+    VERBOSITY_JOBS,      // + uma linha por processo gerado/concluído
+    VERBOSITY_TIMELINE   // + linha temporal em segmentos (RM/EDF)
+} Verbosity;
+
+extern int verbosity;
+
+#define LOG_AT(level, ...) do { if (verbosity >= (level)) out_printf(__VA_ARGS__); } while (0)
+#define LOG(...) LOG_AT(VERBOSITY_SUMMARY, __VA_ARGS__)
+#define LOG_JOB(...) LOG_AT(VERBOSITY_JOBS, __VA_ARGS__)
+
+// Escritor com buffer em blocos grandes para o stdout. Os blocos cheios são
+// escritos por uma thread em segundo plano, pelo que a simulação só espera
+// se todos os blocos estiverem à espera de escrita. Todo o texto para o
+// stdout deve passar por aqui para manter a ordem. É esvaziado à saída do
+// programa (atexit).
+void out_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+void out_write(const char* data, size_t len);
+void out_flush(void);    // escreve tudo o que está pendente e espera
+void out_close(void);    // out_flush e termina a thread de escrita
+
+Verbosity parse_verbosity(const char* str);
+
+#endif
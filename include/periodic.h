@@ -0,0 +1,57 @@
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <signal.h>
+#include "process_table.h"
+#include "timeline.h"
+#include "histogram.h"
+
+// Ponto de partida de uma simulação retomada (checkpoint.h). O estado das
+// tarefas (remaining, next_release, misses) já vem na tabela.
+typedef struct {
+    long long time;         // tempo simulado
+    int clock;              // relógio interno nesse instante (recua na extrapolação)
+    long long cpu_time;
+} PeriodicResume;
+
+// Parâmetros de uma simulação de tarefas periódicas (RM/EDF)
+typedef struct {
+    long long tempo_total;
+    int use_deadline;       // 0 = RM (menor período), 1 = EDF (deadline mais próximo)
+    int cpus;               // processadores partilhados por todas as tarefas (global)
+    Timeline** timelines;   // uma por CPU, ou NULL para não registar
+    int log_misses;         // escreve as linhas MISS (só na thread principal)
+    const PeriodicResume* resume;   // NULL = desde o instante 0
+    // Tempo de resposta (conclusão - liberação) e atraso (conclusão - deadline)
+    // de cada job, incluindo os ciclos extrapolados; NULL para não registar.
+    // Um job que perde o deadline é descartado e conta com o atraso mínimo
+    // (o que lhe faltava correr)
+    Histogram* response;
+    Histogram* lateness;
+} PeriodicSim;
+
+// Resultado da simulação. Quando o estado se repete de hiperperíodo em
+// hiperperíodo, o resto do horizonte é extrapolado: cycles repetições de
+// cycle ticks a partir de steady_from não são simuladas nem registadas na
+// linha temporal (são iguais ao último ciclo registado).
+typedef struct {
+    long long cpu_time;     // tempo total de CPU usado (somado sobre os processadores)
+    long long horizon;      // tempo coberto: tempo_total, salvo se exceder o relógio
+    long long steady_from;  // -1 se não houve extrapolação
+    long long cycle;
+    long long cycles;
+    int clock;              // relógio interno no fim, para um checkpoint
+    int interrupted;        // parada por periodic_stop_requested
+    long long decisions;    // eventos simulados (sem os extrapolados)
+} PeriodicResult;
+
+// Posto a 1 (p.ex. por um sinal) para a simulação parar no próximo evento
+extern volatile sig_atomic_t periodic_stop_requested;
+
+// Simula a tabela até sim->tempo_total; as perdas acumulam em table->misses
+PeriodicResult simulate_periodic(ProcessTable* table, const PeriodicSim* sim);
+
+// Nota sobre a extrapolação/truncatura, a seguir à linha temporal
+void log_periodic_result(const PeriodicResult* result, long long tempo_total);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef POOL_H
+#define POOL_H
+
+// Pool de threads com work stealing para tarefas independentes numeradas
+// 0..num_tasks-1 (execuções do SWEEP, partições do modo MULTI). Cada worker
+// tem um deque: o dono tira do fim, os outros roubam do início.
+typedef void (*PoolTask)(void* ctx, int task);
+
+// Executa fn(ctx, k) para todas as tarefas e espera que terminem
+void pool_run(int workers, int num_tasks, PoolTask fn, void* ctx);
+
+// Número de workers a usar: requested, ou o número de CPUs se for 0
+int pool_workers(int requested);
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include "utils.h"
+
 typedef enum {
     STATIC,
     DYNAMIC
@@ -20,12 +22,52 @@ typedef struct {
     Process* list;
     int size;
     int capacity;
+    void* mapping;          // ficheiro binário mapeado que contém list, ou NULL
+    size_t mapping_size;
 } ProcessQueue;
 
 ProcessQueue* create_process_queue(int capacity);
 void destroy_process_queue(ProcessQueue* queue);
 void add_process(ProcessQueue* queue, Process proc);
-Process generate_random_process(int id, int current_time);
-void load_processes_from_file(ProcessQueue* queue);
+// Gerador de carga: uma stream independente por campo, para que gerar um
+// processo de cada vez ou em lote (generate_processes) dê a mesma sequência
+typedef struct {
+    RngState arrival_rng;
+    RngState burst_rng;
+    RngState priority_rng;
+    RngState period_rng;
+    int cumulative_arrival;   // tempo de chegada cumulativo
+    int next_id;
+} ProcessGenerator;
+
+void init_process_generator(ProcessGenerator* gen, uint64_t seed);
+Process generate_random_process(ProcessGenerator* gen);
+void generate_processes(ProcessGenerator* gen, ProcessQueue* queue, int count);
+
+// Fonte preguiçosa de processos (modo STREAM): gera em blocos à medida que o
+// escalonador os pede, com memória constante seja qual for o total. Com um
+// trace (create_trace_stream) os blocos vêm do trace em vez do gerador.
+#define PROCESS_STREAM_BLOCK 4096
+
+struct TraceReader;
+
+typedef struct {
+    ProcessGenerator gen;
+    struct TraceReader* trace;  // NULL: processos gerados
+    long long remaining;    // processos ainda por gerar (ou ler)
+    long long total;        // -1 se desconhecido (trace)
+    Process block[PROCESS_STREAM_BLOCK];
+    int head;
+    int count;
+} ProcessStream;
+
+ProcessStream* create_process_stream(uint64_t seed, long long total);
+// limit <= 0: o trace inteiro. O trace continua a ser do chamador.
+ProcessStream* create_trace_stream(struct TraceReader* trace, long long limit);
+void destroy_process_stream(ProcessStream* stream);
+const Process* stream_peek(ProcessStream* stream);   // NULL quando esgotado
+Process stream_pop(ProcessStream* stream);
+int load_processes_from_file(ProcessQueue* queue, const char* path);
+int save_processes_binary(const ProcessQueue* queue, const char* path);
 
 #endif
@@ -0,0 +1,44 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include "process.h"
+#include "arena.h"
+
+// Tabela de processos em estrutura-de-vetores: cada campo é uma coluna
+// contígua alinhada a 64 bytes, e o estado de cada execução (tempo restante,
+// próxima liberação, deadlines perdidos) vive na mesma tabela. Os ciclos de
+// pesquisa leem apenas as colunas de que precisam. Todas as colunas são um
+// único bloco da arena, libertado com ela.
+typedef struct {
+    int size;
+
+    // Colunas copiadas da ProcessQueue
+    int* id;
+    int* arrival;
+    int* burst;
+    int* priority;
+    int* period;
+    int* deadline;
+
+    // Estado da execução
+    int* remaining;
+    int* next_release;
+    long long* misses;
+} ProcessTable;
+
+ProcessTable* create_process_table(Arena* arena, const ProcessQueue* queue);
+
+// Reconstrói o registo Process da linha i
+static inline Process table_process(const ProcessTable* table, int i) {
+    Process p;
+    p.id = table->id[i];
+    p.arrival_time = table->arrival[i];
+    p.burst_time = table->burst[i];
+    p.priority = table->priority[i];
+    p.remaining_time = table->remaining[i];
+    p.deadline = table->deadline[i];
+    p.period = table->period[i];
+    return p;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef RBTREE_H
+#define RBTREE_H
+
+#include "arena.h"
+
+// Árvore rubro-negra indexada, usada como fila de prontos ordenada (CFS).
+// Cada elemento é um índice de processo com uma chave e um desempate; a
+// ordem é (chave, desempate). Inserir e remover custam O(log n) e o
+// primeiro elemento fica em cache. Os nós são guardados por id, com o
+// nó 0 como sentinela (folhas e pai da raiz), e a capacidade cresce quando
+// é inserido um índice maior. A memória vem da arena e é libertada com ela.
+typedef struct {
+    long long key;
+    long long tie;
+    int left, right, parent;    // parent = -1 se o id não estiver na árvore
+    int red;
+} RbNode;
+
+typedef struct {
+    RbNode* nodes;  // o id i está em nodes[i + 1]
+    int root;
+    int first;      // nó com a menor chave (0 se vazia)
+    int size;
+    int capacity;
+    Arena* arena;
+} RbTree;
+
+RbTree* create_rb_tree(Arena* arena, int capacity);
+void rb_insert(RbTree* tree, int id, long long key, long long tie);
+void rb_remove(RbTree* tree, int id);
+
+// Primeiro e último id (-1 se vazia) e a chave de um id na árvore
+static inline int rb_first(const RbTree* tree) {
+    return tree->first - 1;
+}
+
+int rb_last(const RbTree* tree);
+
+static inline long long rb_key(const RbTree* tree, int id) {
+    return tree->nodes[id + 1].key;
+}
+
+static inline int rb_contains(const RbTree* tree, int id) {
+    return id < tree->capacity && tree->nodes[id + 1].parent >= 0;
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef RING_H
+#define RING_H
+
+#include "arena.h"
+
+// Fila FIFO circular de índices de processos (fila de prontos do Round Robin).
+// A capacidade é sempre potência de 2 e duplica quando a fila enche; a
+// memória vem da arena e é libertada com ela.
+typedef struct {
+    int* items;
+    int head;
+    int size;
+    int capacity;
+    Arena* arena;
+} RingQueue;
+
+RingQueue* create_ring_queue(Arena* arena, int capacity);
+void ring_push(RingQueue* ring, int id);
+
+// Remove e devolve o elemento da frente (-1 se vazia)
+static inline int ring_pop(RingQueue* ring) {
+    if (ring->size == 0) return -1;
+    int id = ring->items[ring->head];
+    ring->head = (ring->head + 1) & (ring->capacity - 1);
+    ring->size--;
+    return id;
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef RUNQUEUE_H
+#define RUNQUEUE_H
+
+#include "arena.h"
+
+// Fila de prontos multinível: uma FIFO por nível de prioridade e um bitmap
+// com os níveis não vazios, como no escalonador O(1) do Linux. Inserir,
+// remover e encontrar o primeiro nível ocupado custam O(1); as FIFOs são
+// listas ligadas por índice, para que qualquer id saia do meio da fila.
+// A capacidade (ids) cresce quando é inserido um índice maior; a memória
+// vem da arena e é libertada com ela.
+#define RQ_LEVELS 64
+
+typedef struct {
+    unsigned long long bitmap;  // bit l ligado se o nível l não está vazio
+    int head[RQ_LEVELS];
+    int tail[RQ_LEVELS];
+    int* next;
+    int* prev;
+    int* level;     // nível de cada id, -1 se não estiver na fila
+    int size;
+    int capacity;
+    Arena* arena;
+} RunQueue;
+
+RunQueue* create_run_queue(Arena* arena, int capacity);
+void rq_push(RunQueue* rq, int id, int level);
+void rq_remove(RunQueue* rq, int id);
+
+static inline int rq_contains(const RunQueue* rq, int id) {
+    return id < rq->capacity && rq->level[id] >= 0;
+}
+
+// Primeiro nível ocupado a partir de from, dando a volta aos RQ_LEVELS
+// níveis (-1 se vazia). Com from = 0 é simplesmente o menor nível.
+static inline int rq_first_level(const RunQueue* rq, int from) {
+    unsigned long long bits = rq->bitmap;
+    if (!bits) return -1;
+    from &= RQ_LEVELS - 1;
+    if (from) bits = (bits >> from) | (bits << (RQ_LEVELS - from));
+    return (from + __builtin_ctzll(bits)) & (RQ_LEVELS - 1);
+}
+
+// Primeiro id do nível (-1 se vazio)
+static inline int rq_head(const RunQueue* rq, int level) {
+    return rq->head[level];
+}
+
+#endif
@@ -2,6 +2,9 @@
 #define SCHEDULER_H
 
 #include "process.h"
+#include "checkpoint.h"
+#include "histogram.h"
+#include "mlfq.h"
 
 // Enum para os algoritmos de escalonamento
 typedef enum {
@@ -11,29 +14,84 @@ typedef enum {
     PRIORITY_PREEMPTIVE,
     ROUND_ROBIN,
     RATE_MONOTONIC,
-    EDF
+    EDF,
+    CFS,
+    MLFQ
 } SchedulingAlgorithm;
 
+// Parâmetros do CFS, em ticks (--cfs-latency, --cfs-granularity): cada
+// processo pronto corre pelo menos uma vez em cada target_latency, que se
+// alarga quando há mais de target_latency / min_granularity prontos; e um
+// processo nunca é preemptado antes de correr min_granularity
+typedef struct {
+    int target_latency;
+    int min_granularity;
+} CfsTunables;
+
+extern CfsTunables cfs_tunables;
+
+// Parâmetros do MLFQ (--mlfq-levels, --mlfq-quanta, --mlfq-boost): número de
+// níveis, quantum de cada nível em ticks (0 = o quantum da linha de comando,
+// a duplicar em cada nível abaixo) e período do boost (0 = sem boost)
+typedef struct {
+    int levels;
+    int quanta[MLFQ_MAX_LEVELS];
+    int boost_period;
+} MlfqTunables;
+
+extern MlfqTunables mlfq_tunables;
+
+// Métricas de uma execução, devolvidas por todos os escalonadores
+typedef struct {
+    int completed;          // processos concluídos (0 em RM/EDF)
+    float avg_wait;
+    float avg_turnaround;
+    float throughput;
+    float cpu_utilization;
+    long long deadline_misses;  // apenas RM/EDF
+    long long simulated_time;   // ticks cobertos pela simulação
+    long long decisions;        // escolhas do processo a correr (eventos em RM/EDF)
+    // Caudas por job (histogram.h): espera, turnaround e resposta (primeira
+    // vez no CPU) nos escalonadores de jobs; resposta e atraso face ao
+    // deadline em RM/EDF
+    Percentiles wait_tail;
+    Percentiles turnaround_tail;
+    Percentiles response_tail;
+    Percentiles lateness_tail;
+    // Índice de Jain do slowdown (turnaround / burst) dos jobs concluídos:
+    // 1 quando todos atrasam na mesma proporção (escalonadores de jobs)
+    float fairness;
+} SchedulerStats;
+
 // Funções para os algoritmos de escalonamento - modo dinâmico
-void run_fcfs(ProcessQueue* queue);
-void run_sjf(ProcessQueue* queue);
-void run_priority(ProcessQueue* queue, int preemptive);
-void run_round_robin(ProcessQueue* queue, int quantum);
-void run_rm(ProcessQueue* queue);
-void run_edf(ProcessQueue* queue);
+SchedulerStats run_fcfs(ProcessQueue* queue);
+SchedulerStats run_sjf(ProcessQueue* queue);
+SchedulerStats run_priority(ProcessQueue* queue, int preemptive);
+SchedulerStats run_round_robin(ProcessQueue* queue, int quantum);
+SchedulerStats run_cfs(ProcessQueue* queue);
+SchedulerStats run_mlfq(ProcessQueue* queue, int quantum);
+SchedulerStats run_rm(ProcessQueue* queue);
+SchedulerStats run_edf(ProcessQueue* queue);
 
 // Funções para os algoritmos de escalonamento - modo estático
-void run_fcfs_static(ProcessQueue* queue, int tempo_total);
-void run_sjf_static(ProcessQueue* queue, int tempo_total);
-void run_priority_static(ProcessQueue* queue, int preemptive, int tempo_total);
-void run_round_robin_static(ProcessQueue* queue, int quantum, int tempo_total);
-void run_rm_static(ProcessQueue* queue, int tempo_total);
-void run_edf_static(ProcessQueue* queue, int tempo_total);
+SchedulerStats run_fcfs_static(ProcessQueue* queue, int tempo_total);
+SchedulerStats run_sjf_static(ProcessQueue* queue, int tempo_total);
+SchedulerStats run_priority_static(ProcessQueue* queue, int preemptive, int tempo_total);
+SchedulerStats run_round_robin_static(ProcessQueue* queue, int quantum, int tempo_total);
+SchedulerStats run_cfs_static(ProcessQueue* queue, int tempo_total);
+SchedulerStats run_mlfq_static(ProcessQueue* queue, int quantum, int tempo_total);
+SchedulerStats run_rm_static(ProcessQueue* queue, long long tempo_total);
+SchedulerStats run_edf_static(ProcessQueue* queue, long long tempo_total);
+// RM/EDF estático retomado de e/ou gravado num checkpoint
+SchedulerStats run_periodic_checkpointed(ProcessQueue* queue, SchedulingAlgorithm algo,
+                                         long long tempo_total, const CheckpointConfig* checkpoint);
 
 // Função para chamar o escalonador com base no algoritmo e no modo
-void run_scheduler(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum);
-void run_scheduler_static(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum, int tempo_total);
+SchedulerStats run_scheduler(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum);
+SchedulerStats run_scheduler_static(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum, long long tempo_total);
+SchedulerStats run_scheduler_stream(ProcessStream* stream, SchedulingAlgorithm algo, int quantum);
 
 SchedulingAlgorithm parse_algo(const char* str);
+const char* algo_name(SchedulingAlgorithm algo);
 
 #endif
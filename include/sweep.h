@@ -0,0 +1,34 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdio.h>
+#include "scheduler.h"
+
+// Varrimento de parâmetros: cada combinação (seed, algoritmo, quantum) é uma
+// execução independente, distribuída por um pool de threads com work stealing.
+// O quantum só é variado nos algoritmos que o usam (Round Robin e MLFQ).
+typedef struct {
+    SchedulingAlgorithm* algos;
+    int num_algos;
+    int* seeds;
+    int num_seeds;
+    int* quanta;
+    int num_quanta;
+    int num_processes;
+    int threads;        // 0 = número de CPUs disponíveis
+    int jsonl;          // 0 = CSV, 1 = JSON lines
+} SweepConfig;
+
+// Lista "1,4,8" e/ou intervalos "1-100" em *out (a libertar com free).
+// Devolve o número de valores, ou 0 (com *out = NULL) se a lista for
+// inválida: texto que não é um número, intervalo invertido, valor fora do
+// int ou mais de INT_LIST_MAX valores no total.
+#define INT_LIST_MAX 1000000
+
+int parse_int_list(const char* str, int** out);
+
+// Só RR e MLFQ variam com o quantum; os restantes correm uma vez por seed
+int uses_quantum(SchedulingAlgorithm algo);
+int run_sweep(const SweepConfig* config, FILE* out);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdbool.h>
+
+// Linha temporal da execução em segmentos [start, end) em vez de uma linha
+// por tick: um processo que corre centenas de ticks seguidos ocupa um só
+// segmento. Usada pelos escalonadores de tempo real (RM/EDF).
+typedef struct {
+    int start;
+    int end;          // exclusivo
+    int pid;          // -1 = CPU ociosa
+    int misses;       // deadlines perdidos detetados no instante start
+    bool preempted;   // o job foi interrompido em end sem ter terminado
+} Segment;
+
+typedef struct {
+    Segment* segments;
+    int size;
+    int capacity;
+} Timeline;
+
+Timeline* create_timeline(int capacity);
+void destroy_timeline(Timeline* timeline);
+// Acrescenta [start, end) com o processo pid; prolonga o último segmento se
+// for o mesmo processo, contíguo e sem perdas de deadline no meio
+void timeline_append(Timeline* timeline, int start, int end, int pid, int misses);
+void timeline_mark_preempted(Timeline* timeline);
+void print_timeline(const Timeline* timeline);
+
+#endif
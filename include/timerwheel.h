@@ -0,0 +1,47 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "arena.h"
+
+// Roda de temporizadores hierárquica (Varghese & Lauck) para instantes de
+// 32 bits: WHEEL_LEVELS níveis de WHEEL_SLOTS ranhuras, cada nível com uma
+// granularidade WHEEL_SLOTS vezes maior que o anterior. Um temporizador fica
+// no nível do primeiro dígito (base WHEEL_SLOTS) em que difere do instante
+// atual; ao avançar o relógio só a ranhura onde o novo instante cai desce
+// de nível, e os que vencem ficam todos na mesma ranhura do nível 0.
+// Agendar e vencer custam O(1) por temporizador (mais uma descida por
+// nível, no máximo); o próximo vencimento sai dos bitmaps e fica em cache.
+// Os ids são índices de 0 a capacity - 1, cada um com no máximo um
+// temporizador; a memória vem da arena e é libertada com ela.
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 6      // 36 bits cobrem o relógio int
+
+typedef struct {
+    unsigned long long bitmap[WHEEL_LEVELS];    // ranhuras não vazias
+    int head[WHEEL_LEVELS][WHEEL_SLOTS];        // listas ligadas por índice
+    int* next;
+    int* when;      // instante de cada id, -1 se não estiver agendado
+    int now;
+    int next_due;   // cache de wheel_next, -1 se por calcular
+    int size;
+    int capacity;
+} TimerWheel;
+
+TimerWheel* create_timer_wheel(Arena* arena, int capacity, int now);
+
+// Esvazia a roda e recomeça no instante now
+void wheel_reset(TimerWheel* wheel, int now);
+
+// Agenda id para o instante when >= now (o id não pode estar agendado)
+void wheel_schedule(TimerWheel* wheel, int id, int when);
+
+// Instante do próximo vencimento (INT_MAX se vazia)
+int wheel_next(TimerWheel* wheel);
+
+// Avança o relógio para time <= wheel_next e retira os ids que vencem em
+// time para due (com espaço para capacity ids), por ordem arbitrária;
+// devolve quantos são
+int wheel_advance(TimerWheel* wheel, int time, int* due);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "process.h"
+
+// Importação de traces do escalonador do Linux em texto: saída de
+// `perf script`/`perf sched script` ou do ficheiro trace do ftrace, com
+// eventos sched_switch e sched_wakeup/sched_wakeup_new/sched_waking (nos
+// formatos chave=valor do kernel e compacto do libtraceevent). O resto das
+// linhas é ignorado.
+//
+// Cada job é um burst de CPU de uma tarefa: chega quando a tarefa acorda
+// (ou quando aparece a correr sem ter acordado no trace), acumula o tempo
+// em que está no CPU, mesmo se preemptada (prev_state R), e acaba quando a
+// tarefa bloqueia ou sai. O id é o pid e a prioridade é o nice (prio - 120,
+// limitado a [-20, 19]; tempo real conta como -20). Tempos em ticks de
+// tick_us microssegundos, a partir do primeiro evento; bursts arredondados,
+// com pelo menos 1 tick.
+//
+// O ficheiro é lido em blocos (ou de stdin, com "-") e os jobs saem por
+// ordem de chegada à medida que acabam, com memória limitada às tarefas
+// conhecidas e aos jobs ainda abertos: se houver TRACE_PENDING jobs à
+// espera de um mais antigo que não acaba, este é partido e o resto do burst
+// conta como um job novo.
+#define TRACE_PENDING (1 << 16)
+
+typedef struct TraceReader TraceReader;
+
+// NULL (com a mensagem em stderr) se o ficheiro não abrir
+TraceReader* open_trace(const char* path, int tick_us);
+void close_trace(TraceReader* trace);
+
+// Até max jobs seguintes em out, por ordem de chegada; 0 no fim do trace
+int trace_read(TraceReader* trace, Process* out, int max);
+
+// Linha de resumo: bytes, eventos, jobs e ritmo de leitura
+void log_trace_summary(const TraceReader* trace);
+
+#endif
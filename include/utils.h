@@ -1,6 +1,60 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdio.h>
+#include <stdint.h>
+
+// Gerador xoshiro256** com estado explícito: cada stream é independente e
+// pode ser usada por uma thread sem sincronização
+typedef struct {
+    uint64_t s[4];
+} RngState;
+
+void rng_seed(RngState* rng, uint64_t seed);
+void rng_jump(RngState* rng);   // avança 2^128 passos (nova stream disjunta)
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(RngState* rng) {
+    uint64_t* s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Uniforme em [0, 1) com 53 bits de mantissa
+static inline double rng_uniform(RngState* rng) {
+    return (rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+// Inteiro uniforme em [0, n)
+static inline int rng_below(RngState* rng, int n) {
+    return (int)(((rng_next(rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+double rng_exponential(RngState* rng, double lambda);
+double rng_normal(RngState* rng, double mean, double std_dev);
+double rng_poisson(RngState* rng, double lambda);
+
+// Kernels em lote: primeiro enchem o vetor de uniformes, depois aplicam a
+// transformação num ciclo sem ramificações (vetorizável pelo compilador)
+void fill_uniform(RngState* rng, double* out, int n);
+void fill_exponential(RngState* rng, double lambda, double* out, int n);
+void fill_normal(RngState* rng, double mean, double std_dev, double* out, int n);
+void fill_poisson(RngState* rng, double lambda, double* out, int n);
+
+// Versões com a stream por omissão da thread (semeada com seed_default_rng)
+void seed_default_rng(uint64_t seed);
+void save_default_rng(RngState* out);        // para os checkpoints
+void restore_default_rng(const RngState* state);
 double generate_exponential(double lambda);
 double generate_poisson(double lambda);
 double generate_normal(double mean, double std_dev);
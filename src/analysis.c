@@ -0,0 +1,242 @@
+#include <stdlib.h>
+#include <math.h>
+#include "analysis.h"
+#include "output.h"
+
+typedef struct {
+    int id;
+    long long c, t, d;
+} Task;
+
+typedef struct {
+    Task* tasks;        // pela ordem original (desempate do RM)
+    int n;
+    int synchronous;    // todas chegam no mesmo instante
+    int one_shot;       // tarefas sem período com burst > 0
+    int implicit;       // D = T em todas
+    double utilization;
+} TaskSet;
+
+static TaskSet build_task_set(const ProcessQueue* queue) {
+    TaskSet set = { malloc(sizeof(Task) * (queue->size > 0 ? queue->size : 1)), 0, 1, 0, 1, 0 };
+    int first_arrival = -1;
+    for (int i = 0; i < queue->size; i++) {
+        const Process* p = &queue->list[i];
+        if (p->burst_time <= 0) continue;
+        if (p->period <= 0) {
+            set.one_shot++;
+            continue;
+        }
+        if (first_arrival < 0) first_arrival = p->arrival_time;
+        if (p->arrival_time != first_arrival) set.synchronous = 0;
+
+        Task* task = &set.tasks[set.n++];
+        task->id = p->id;
+        task->c = p->burst_time;
+        task->t = p->period;
+        task->d = p->deadline - p->arrival_time;
+        if (task->d <= 0 || task->d > task->t) task->d = task->t;
+        if (task->d != task->t) set.implicit = 0;
+        set.utilization += (double)task->c / task->t;
+    }
+    return set;
+}
+
+// Um resultado exato supõe o instante crítico: com chegadas desfasadas a
+// falha pode não acontecer, e tarefas sem período acrescentam carga
+static Feasibility adjust(const TaskSet* set, Feasibility f) {
+    if (f == INFEASIBLE && !set->synchronous) return INCONCLUSIVE;
+    if (f == FEASIBLE && set->one_shot) return INCONCLUSIVE;
+    return f;
+}
+
+const char* feasibility_name(Feasibility f) {
+    switch (f) {
+        case FEASIBLE: return "escalonável";
+        case INFEASIBLE: return "não escalonável";
+        case INCONCLUSIVE: return "inconclusivo";
+        default: return "não se aplica";
+    }
+}
+
+// ======== RM =========
+static const TaskSet* sort_set;
+
+// Prioridade RM do simulador: menor período, empates pelo menor índice
+static int compare_rm_priority(const void* a, const void* b) {
+    int i = *(const int*)a, j = *(const int*)b;
+    const Task* x = &sort_set->tasks[i];
+    const Task* y = &sort_set->tasks[j];
+    if (x->t != y->t) return x->t < y->t ? -1 : 1;
+    return i - j;
+}
+
+// Tempo de resposta no pior caso da tarefa order[k], com as order[0..k-1]
+// de maior prioridade: R = C + soma(ceil(R / Tj) * Cj), até estabilizar ou
+// passar o deadline (nesse caso devolve um valor > D)
+static long long response_time(const TaskSet* set, const int* order, int k) {
+    const Task* task = &set->tasks[order[k]];
+    long long r = task->c, prev = 0;
+    while (r != prev && r <= task->d) {
+        prev = r;
+        r = task->c;
+        for (int j = 0; j < k; j++) {
+            const Task* hp = &set->tasks[order[j]];
+            r += (prev + hp->t - 1) / hp->t * hp->c;
+        }
+    }
+    return r;
+}
+
+SchedAnalysis analyze_rm(const ProcessQueue* queue) {
+    TaskSet set = build_task_set(queue);
+    SchedAnalysis result = { set.n, set.utilization, NOT_APPLICABLE, NOT_APPLICABLE, INCONCLUSIVE, INCONCLUSIVE };
+    int n = set.n;
+
+    LOG("\n[RM] Análise de escalonabilidade: %d tarefa(s), U = %.4f\n", n, set.utilization);
+
+    // Limites de utilização (suficientes, só com D = T)
+    if (set.implicit) {
+        double bound = n > 0 ? n * (pow(2.0, 1.0 / n) - 1.0) : 1.0;
+        double product = 1.0;
+        for (int i = 0; i < n; i++)
+            product *= (double)set.tasks[i].c / set.tasks[i].t + 1.0;
+        result.utilization_bound = adjust(&set, set.utilization <= bound ? FEASIBLE : INCONCLUSIVE);
+        result.hyperbolic = adjust(&set, product <= 2.0 ? FEASIBLE : INCONCLUSIVE);
+        LOG("Liu & Layland (U <= %.4f): %s\n", bound, feasibility_name(result.utilization_bound));
+        LOG("Hiperbólico (prod(U + 1) = %.4f <= 2): %s\n", product, feasibility_name(result.hyperbolic));
+    }
+
+    // Análise do tempo de resposta (exata para libertação síncrona)
+    if (set.utilization > 1.0) {
+        result.exact = INFEASIBLE;
+    } else {
+        int* order = malloc(sizeof(int) * (n > 0 ? n : 1));
+        for (int i = 0; i < n; i++)
+            order[i] = i;
+        sort_set = &set;
+        qsort(order, n, sizeof(int), compare_rm_priority);
+
+        Feasibility exact = FEASIBLE;
+        for (int k = 0; k < n; k++) {
+            const Task* task = &set.tasks[order[k]];
+            long long r = response_time(&set, order, k);
+            if (r > task->d) {
+                exact = INFEASIBLE;
+                LOG_JOB("Processo %d: R > %lld = D (perde o deadline)\n", task->id, task->d);
+            } else {
+                LOG_JOB("Processo %d: R = %lld, D = %lld\n", task->id, r, task->d);
+            }
+        }
+        free(order);
+        result.exact = adjust(&set, exact);
+    }
+    LOG("Tempo de resposta: %s\n", feasibility_name(result.exact));
+
+    if (set.utilization > 1.0) result.verdict = INFEASIBLE;
+    else if (result.utilization_bound == FEASIBLE || result.hyperbolic == FEASIBLE) result.verdict = FEASIBLE;
+    else result.verdict = result.exact;
+    LOG("Veredicto: %s\n", feasibility_name(result.verdict));
+
+    free(set.tasks);
+    return result;
+}
+// =====================
+
+// ======== EDF =========
+// Procura de processador h(t): trabalho com deadline absoluto <= t
+static long long demand(const TaskSet* set, long long t) {
+    long long h = 0;
+    for (int i = 0; i < set->n; i++) {
+        const Task* task = &set->tasks[i];
+        if (t >= task->d) h += ((t - task->d) / task->t + 1) * task->c;
+    }
+    return h;
+}
+
+// Maior deadline absoluto estritamente menor que t (0 se não houver)
+static long long previous_deadline(const TaskSet* set, long long t) {
+    long long best = 0;
+    for (int i = 0; i < set->n; i++) {
+        const Task* task = &set->tasks[i];
+        if (t <= task->d) continue;
+        long long d = (t - 1 - task->d) / task->t * task->t + task->d;
+        if (d > best) best = d;
+    }
+    return best;
+}
+
+#define BUSY_PERIOD_ITERATIONS 1000000
+
+// Limite L dos instantes a verificar: o período ocupado síncrono e, com
+// U < 1, o limite de Baruah (La); -1 se o período ocupado não estabilizar
+static long long demand_horizon(const TaskSet* set) {
+    long long w = 0, prev = -1;
+    for (int i = 0; i < set->n; i++)
+        w += set->tasks[i].c;
+    for (int it = 0; w != prev; it++) {
+        if (it == BUSY_PERIOD_ITERATIONS) return -1;
+        prev = w;
+        w = 0;
+        for (int i = 0; i < set->n; i++)
+            w += (prev + set->tasks[i].t - 1) / set->tasks[i].t * set->tasks[i].c;
+    }
+
+    if (set->utilization < 1.0) {
+        double la = 0;
+        long long d_max = 0;
+        for (int i = 0; i < set->n; i++) {
+            const Task* task = &set->tasks[i];
+            la += (double)(task->t - task->d) * task->c / task->t;
+            if (task->d > d_max) d_max = task->d;
+        }
+        la /= 1.0 - set->utilization;
+        if (la < d_max) la = d_max;
+        if (la < w) w = (long long)ceil(la);
+    }
+    return w;
+}
+
+// QPA (Zhang & Burns): percorre os deadlines para trás a partir de L,
+// saltando diretamente para h(t) sempre que h(t) < t
+static Feasibility processor_demand(const TaskSet* set) {
+    long long horizon = demand_horizon(set);
+    if (horizon < 0) return INCONCLUSIVE;
+
+    long long d_min = horizon;
+    for (int i = 0; i < set->n; i++)
+        if (set->tasks[i].d < d_min) d_min = set->tasks[i].d;
+
+    long long t = previous_deadline(set, horizon + 1);
+    long long h = demand(set, t);
+    while (h <= t && h > d_min) {
+        t = h < t ? h : previous_deadline(set, t);
+        h = demand(set, t);
+    }
+    return h <= d_min ? FEASIBLE : INFEASIBLE;
+}
+
+SchedAnalysis analyze_edf(const ProcessQueue* queue) {
+    TaskSet set = build_task_set(queue);
+    SchedAnalysis result = { set.n, set.utilization, NOT_APPLICABLE, NOT_APPLICABLE, INCONCLUSIVE, INCONCLUSIVE };
+
+    LOG("\n[EDF] Análise de escalonabilidade: %d tarefa(s), U = %.4f\n", set.n, set.utilization);
+
+    // Com D = T, U <= 1 é exato mesmo com chegadas desfasadas
+    if (set.utilization > 1.0) result.utilization_bound = INFEASIBLE;
+    else if (set.implicit) result.utilization_bound = adjust(&set, FEASIBLE);
+    else result.utilization_bound = INCONCLUSIVE;
+    LOG("Utilização (U <= 1): %s\n", feasibility_name(result.utilization_bound));
+
+    result.exact = set.utilization > 1.0 ? INFEASIBLE : adjust(&set, processor_demand(&set));
+    LOG("Procura de processador: %s\n", feasibility_name(result.exact));
+
+    if (set.utilization > 1.0) result.verdict = INFEASIBLE;
+    else if (result.utilization_bound == FEASIBLE) result.verdict = FEASIBLE;
+    else result.verdict = result.exact;
+    LOG("Veredicto: %s\n", feasibility_name(result.verdict));
+
+    free(set.tasks);
+    return result;
+}
+// ======================
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "arena.h"
+
+#define HUGE_PAGE_SIZE (2u << 20)
+#define THREAD_ARENA_SIZE (1u << 20)
+#define BLOCK_HEADER 64   // o cabeçalho ocupa uma linha de cache
+
+struct ArenaBlock {
+    ArenaBlock* prev;
+    int index;
+    size_t size;    // bytes utilizáveis em data
+    size_t used;
+    size_t mapped;  // tamanho do mapeamento, com o cabeçalho
+    char* data;
+};
+
+int arena_huge_pages = 0;
+
+static size_t round_up(size_t value, size_t to) {
+    return (value + to - 1) / to * to;
+}
+
+static ArenaBlock* map_block(size_t size, int huge_pages, ArenaBlock* prev) {
+    size_t page = huge_pages ? HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapped = round_up(BLOCK_HEADER + size, page);
+    void* base = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (huge_pages)
+        base = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (base == MAP_FAILED) {
+        base = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+        if (base != MAP_FAILED && huge_pages) madvise(base, mapped, MADV_HUGEPAGE);
+#endif
+    }
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Erro: sem memória para a arena (%zu bytes)\n", mapped);
+        exit(1);
+    }
+
+    ArenaBlock* block = base;
+    block->prev = prev;
+    block->index = prev ? prev->index + 1 : 0;
+    block->size = mapped - BLOCK_HEADER;
+    block->used = 0;
+    block->mapped = mapped;
+    block->data = (char*)base + BLOCK_HEADER;
+    return block;
+}
+
+Arena* create_arena(size_t capacity, int huge_pages) {
+    Arena* arena = malloc(sizeof(Arena));
+    arena->block = map_block(capacity, huge_pages, NULL);
+    arena->total = 0;
+    arena->peak = 0;
+    arena->grown = 0;
+    arena->huge_pages = huge_pages;
+    return arena;
+}
+
+void destroy_arena(Arena* arena) {
+    ArenaBlock* block = arena->block;
+    while (block) {
+        ArenaBlock* prev = block->prev;
+        munmap(block, block->mapped);
+        block = prev;
+    }
+    free(arena);
+}
+
+void* arena_alloc_aligned(Arena* arena, size_t size, size_t align) {
+    ArenaBlock* block = arena->block;
+    uintptr_t top = (uintptr_t)(block->data + block->used);
+    size_t pad = (size_t)(((top + align - 1) & ~(uintptr_t)(align - 1)) - top);
+    if (block->used + pad + size > block->size) {
+        // Bloco novo com pelo menos o dobro do atual; o resto deste fica por
+        // usar até à marca
+        size_t want = size + align > 2 * block->size ? size + align : 2 * block->size;
+        block = arena->block = map_block(want, arena->huge_pages, block);
+        arena->grown = 1;
+        top = (uintptr_t)block->data;
+        pad = (size_t)(((top + align - 1) & ~(uintptr_t)(align - 1)) - top);
+    }
+    void* ptr = block->data + block->used + pad;
+    block->used += pad + size;
+    arena->total += pad + size;
+    if (arena->total > arena->peak) arena->peak = arena->total;
+    return ptr;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    return arena_alloc_aligned(arena, size, ARENA_ALIGN);
+}
+
+void* arena_grow(Arena* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!ptr) return arena_alloc(arena, new_size);
+    if (new_size <= old_size) return ptr;
+
+    ArenaBlock* block = arena->block;
+    char* end = (char*)ptr + old_size;
+    if (end == block->data + block->used && (size_t)((char*)ptr - block->data) + new_size <= block->size) {
+        block->used += new_size - old_size;
+        arena->total += new_size - old_size;
+        if (arena->total > arena->peak) arena->peak = arena->total;
+        return ptr;
+    }
+    void* moved = arena_alloc(arena, new_size);
+    memcpy(moved, ptr, old_size);
+    return moved;
+}
+
+ArenaMark arena_mark(const Arena* arena) {
+    ArenaMark mark = { arena->block->index, arena->block->used, arena->total };
+    return mark;
+}
+
+void arena_release(Arena* arena, ArenaMark mark) {
+    while (arena->block->index > mark.block) {
+        ArenaBlock* prev = arena->block->prev;
+        munmap(arena->block, arena->block->mapped);
+        arena->block = prev;
+    }
+    arena->block->used = mark.used;
+    arena->total = mark.total;
+
+    // Arena vazia depois de ter precisado de mais blocos: um só bloco com o
+    // pico (e folga para o alinhamento) para a próxima execução caber nele
+    if (arena->grown && mark.block == 0 && mark.used == 0) {
+        size_t want = arena->peak + arena->peak / 4;
+        munmap(arena->block, arena->block->mapped);
+        arena->block = map_block(want, arena->huge_pages, NULL);
+        arena->grown = 0;
+    }
+}
+
+// ======== ARENA POR THREAD =========
+static pthread_key_t arena_key;
+static pthread_once_t arena_key_once = PTHREAD_ONCE_INIT;
+static _Thread_local Arena* current_arena;
+
+static void release_thread_arena(void* arena) {
+    destroy_arena(arena);
+}
+
+static void create_arena_key(void) {
+    pthread_key_create(&arena_key, release_thread_arena);
+}
+
+Arena* thread_arena(void) {
+    if (!current_arena) {
+        pthread_once(&arena_key_once, create_arena_key);
+        current_arena = create_arena(THREAD_ARENA_SIZE, arena_huge_pages);
+        pthread_setspecific(arena_key, current_arena);
+    }
+    return current_arena;
+}
+// ===================================
@@ -0,0 +1,129 @@
+#include <limits.h>
+#include "argmin.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARGMIN_X86 1
+#endif
+
+typedef int (*ArgminKernel)(const int*, const int*, int, const int*, int, int);
+
+static int argmin_scalar_from(const int* key, const int* gate, int gate_min,
+                              const int* arrival, int time, int start, int n,
+                              int best, int best_key) {
+    for (int i = start; i < n; i++) {
+        if (gate[i] >= gate_min && arrival[i] <= time && (best < 0 || key[i] < best_key)) {
+            best = i;
+            best_key = key[i];
+        }
+    }
+    return best;
+}
+
+static int argmin_scalar(const int* key, const int* gate, int gate_min,
+                         const int* arrival, int time, int n) {
+    return argmin_scalar_from(key, gate, gate_min, arrival, time, 0, n, -1, 0);
+}
+
+// Junta os candidatos de cada lane (índice -1 = lane sem elegíveis)
+static void reduce_lanes(const int* keys, const int* idx, int lanes, int* best, int* best_key) {
+    for (int l = 0; l < lanes; l++) {
+        if (idx[l] < 0) continue;
+        if (*best < 0 || keys[l] < *best_key || (keys[l] == *best_key && idx[l] < *best)) {
+            *best = idx[l];
+            *best_key = keys[l];
+        }
+    }
+}
+
+#ifdef ARGMIN_X86
+// Cada lane guarda o seu melhor (chave, índice); como os índices de uma lane
+// crescem, a comparação estrita mantém o primeiro em caso de empate
+__attribute__((target("avx2")))
+static int argmin_avx2(const int* key, const int* gate, int gate_min,
+                       const int* arrival, int time, int n) {
+    __m256i best_key = _mm256_set1_epi32(INT_MAX);
+    __m256i best_idx = _mm256_set1_epi32(-1);
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i gate_lim = _mm256_set1_epi32(gate_min - 1);
+    __m256i time_v = _mm256_set1_epi32(time);
+    __m256i none = _mm256_set1_epi32(-1);
+    __m256i step = _mm256_set1_epi32(8);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i k = _mm256_loadu_si256((const __m256i*)(key + i));
+        __m256i g = _mm256_loadu_si256((const __m256i*)(gate + i));
+        __m256i a = _mm256_loadu_si256((const __m256i*)(arrival + i));
+        __m256i eligible = _mm256_andnot_si256(_mm256_cmpgt_epi32(a, time_v),
+                                               _mm256_cmpgt_epi32(g, gate_lim));
+        __m256i better = _mm256_or_si256(_mm256_cmpgt_epi32(best_key, k),
+                                         _mm256_cmpeq_epi32(best_idx, none));
+        __m256i update = _mm256_and_si256(eligible, better);
+        best_key = _mm256_blendv_epi8(best_key, k, update);
+        best_idx = _mm256_blendv_epi8(best_idx, idx, update);
+        idx = _mm256_add_epi32(idx, step);
+    }
+
+    int keys[8], idxs[8], best = -1, best_k = 0;
+    _mm256_storeu_si256((__m256i*)keys, best_key);
+    _mm256_storeu_si256((__m256i*)idxs, best_idx);
+    reduce_lanes(keys, idxs, 8, &best, &best_k);
+    return argmin_scalar_from(key, gate, gate_min, arrival, time, i, n, best, best_k);
+}
+
+__attribute__((target("sse4.1")))
+static int argmin_sse41(const int* key, const int* gate, int gate_min,
+                        const int* arrival, int time, int n) {
+    __m128i best_key = _mm_set1_epi32(INT_MAX);
+    __m128i best_idx = _mm_set1_epi32(-1);
+    __m128i idx = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i gate_lim = _mm_set1_epi32(gate_min - 1);
+    __m128i time_v = _mm_set1_epi32(time);
+    __m128i none = _mm_set1_epi32(-1);
+    __m128i step = _mm_set1_epi32(4);
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i k = _mm_loadu_si128((const __m128i*)(key + i));
+        __m128i g = _mm_loadu_si128((const __m128i*)(gate + i));
+        __m128i a = _mm_loadu_si128((const __m128i*)(arrival + i));
+        __m128i eligible = _mm_andnot_si128(_mm_cmpgt_epi32(a, time_v),
+                                            _mm_cmpgt_epi32(g, gate_lim));
+        __m128i better = _mm_or_si128(_mm_cmpgt_epi32(best_key, k),
+                                      _mm_cmpeq_epi32(best_idx, none));
+        __m128i update = _mm_and_si128(eligible, better);
+        best_key = _mm_blendv_epi8(best_key, k, update);
+        best_idx = _mm_blendv_epi8(best_idx, idx, update);
+        idx = _mm_add_epi32(idx, step);
+    }
+
+    int keys[4], idxs[4], best = -1, best_k = 0;
+    _mm_storeu_si128((__m128i*)keys, best_key);
+    _mm_storeu_si128((__m128i*)idxs, best_idx);
+    reduce_lanes(keys, idxs, 4, &best, &best_k);
+    return argmin_scalar_from(key, gate, gate_min, arrival, time, i, n, best, best_k);
+}
+#endif
+
+static ArgminKernel select_kernel(void) {
+#ifdef ARGMIN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return argmin_avx2;
+    if (__builtin_cpu_supports("sse4.1")) return argmin_sse41;
+#endif
+    return argmin_scalar;
+}
+
+int argmin_masked(const int* key, const int* gate, int gate_min,
+                  const int* arrival, int time, int n) {
+    // Várias threads do SWEEP podem chegar aqui ao mesmo tempo; todas
+    // escolheriam o mesmo kernel
+    static ArgminKernel kernel;
+    ArgminKernel k = __atomic_load_n(&kernel, __ATOMIC_RELAXED);
+    if (!k) {
+        k = select_kernel();
+        __atomic_store_n(&kernel, k, __ATOMIC_RELAXED);
+    }
+    return k(key, gate, gate_min, arrival, time, n);
+}
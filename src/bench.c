@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "process.h"
+#include "output.h"
+#include "utils.h"
+
+// RM/EDF percorrem as n tarefas em cada evento: acima deste produto
+// n * horizonte a execução demoraria horas e é ignorada
+#define BENCH_PERIODIC_WORK 1e10
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// Pico de RSS desde o último reset_peak_rss, em kB (VmHWM). Sem
+// /proc/self/clear_refs o pico é o do processo inteiro.
+static void reset_peak_rss(void) {
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (!f) return;
+    fputs("5", f);
+    fclose(f);
+}
+
+static long peak_rss_kb(void) {
+    FILE* f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), f))
+        if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) break;
+    fclose(f);
+    return kb;
+}
+
+int run_bench(const BenchConfig* config, FILE* csv) {
+    int saved_verbosity = verbosity;
+    verbosity = VERBOSITY_QUIET;
+
+    // A mesma seed gera sempre a mesma sequência: cada carga é o prefixo da
+    // maior, gerada uma só vez
+    int max_size = 0;
+    for (int s = 0; s < config->num_sizes; s++)
+        if (config->sizes[s] > max_size) max_size = config->sizes[s];
+    ProcessGenerator gen;
+    init_process_generator(&gen, config->seed);
+    ProcessQueue* workload = create_process_queue(max_size > 0 ? max_size : 1);
+    generate_processes(&gen, workload, max_size);
+
+    // Bursts próprios, com uma stream disjunta das do gerador: chegadas e
+    // prioridades ficam as mesmas
+    RngState burst_rng;
+    rng_seed(&burst_rng, config->seed);
+    for (int j = 0; j < 3; j++) rng_jump(&burst_rng);
+    double* bursts = malloc(sizeof(double) * (max_size > 0 ? max_size : 1));
+    fill_exponential(&burst_rng, 1.0 / config->mean_burst, bursts, max_size);
+    for (int i = 0; i < max_size; i++) {
+        Process* p = &workload->list[i];
+        p->burst_time = bursts[i] < 1 ? 1 : bursts[i] > 1e9 ? 1000000000 : (int)bursts[i];
+        p->remaining_time = p->burst_time;
+    }
+    free(bursts);
+
+    out_printf("Carga: bursts exponenciais de média %.1f ticks, quantum %d\n", config->mean_burst, config->quantum);
+
+    // "decisões" tem um carácter de 2 bytes: largura + 1 para alinhar
+    out_printf("%-8s %10s %12s %14s %13s %11s %12s %13s %10s\n", "algo", "processos", "horizonte",
+               "ticks", "decisões", "tempo(ms)", "ticks/s", "decisões/s", "RSS(MB)");
+    if (csv)
+        fprintf(csv, "algo,processes,mean_burst,quantum,horizon,simulated_ticks,decisions,wall_ms,"
+                     "ticks_per_sec,decisions_per_sec,peak_rss_kb\n");
+
+    int runs = 0;
+    for (int s = 0; s < config->num_sizes; s++) {
+        // Os escalonadores estáticos só leem a fila: todas as execuções
+        // partilham a carga
+        ProcessQueue view = *workload;
+        view.size = config->sizes[s];
+        view.capacity = view.size;
+
+        for (int h = 0; h < config->num_horizons; h++) {
+            for (int a = 0; a < config->num_algos; a++) {
+                SchedulingAlgorithm algo = config->algos[a];
+                int horizon = config->horizons[h];
+                if ((algo == RATE_MONOTONIC || algo == EDF) &&
+                    (double)view.size * horizon > BENCH_PERIODIC_WORK) {
+                    out_printf("%-8s %10d %12d   ignorado (processos x horizonte > %.0e)\n",
+                               algo_name(algo), view.size, horizon, BENCH_PERIODIC_WORK);
+                    continue;
+                }
+
+                reset_peak_rss();
+                double start = now_ms();
+                SchedulerStats stats = run_scheduler_static(&view, algo, config->quantum, horizon);
+                double elapsed = now_ms() - start;
+                long rss = peak_rss_kb();
+
+                double seconds = elapsed > 0 ? elapsed / 1e3 : 1e-9;
+                double ticks_rate = stats.simulated_time / seconds;
+                double decision_rate = stats.decisions / seconds;
+                out_printf("%-8s %10d %12d %14lld %12lld %11.2f %12.3g %12.3g %10.1f\n",
+                           algo_name(algo), view.size, horizon, stats.simulated_time, stats.decisions,
+                           elapsed, ticks_rate, decision_rate, rss / 1024.0);
+                out_flush();
+                if (csv)
+                    fprintf(csv, "%s,%d,%.2f,%d,%d,%lld,%lld,%.3f,%.0f,%.0f,%ld\n", algo_name(algo), view.size,
+                            config->mean_burst, config->quantum, horizon, stats.simulated_time, stats.decisions, elapsed,
+                            ticks_rate, decision_rate, rss);
+                runs++;
+            }
+        }
+    }
+    if (csv) fflush(csv);
+
+    destroy_process_queue(workload);
+    verbosity = saved_verbosity;
+    return runs;
+}
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include "checkpoint.h"
+#include "utils.h"
+
+// Formato: cabeçalho CheckpointHeader seguido das colunas remaining e
+// next_release (int) e misses (long long) da tabela, na ordem de bytes da
+// máquina, como os ficheiros de carga binários.
+static const char CHECKPOINT_MAGIC[8] = { 'P', 'S', 'C', 'H', 'E', 'D', 'C', '1' };
+
+typedef struct {
+    char magic[8];
+    uint32_t tasks;
+    uint32_t use_deadline;
+    uint64_t workload;      // impressão digital das colunas de entrada
+    int64_t time;
+    int64_t cpu_time;
+    int32_t clock;
+    uint32_t reserved;
+    RngState rng;
+} CheckpointHeader;
+
+// FNV-1a sobre as colunas que definem as tarefas periódicas
+static uint64_t workload_fingerprint(const ProcessTable* table) {
+    const int* columns[] = { table->id, table->arrival, table->burst, table->period, table->deadline };
+    size_t bytes = sizeof(int) * (size_t)table->size;
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (int c = 0; c < 5; c++) {
+        const unsigned char* data = (const unsigned char*)columns[c];
+        for (size_t k = 0; k < bytes; k++) {
+            h ^= data[k];
+            h *= 0x100000001b3ULL;
+        }
+    }
+    return h;
+}
+
+// Escreve num ficheiro temporário e renomeia no fim: um checkpoint
+// interrompido a meio nunca substitui o anterior
+int save_checkpoint(const char* path, const ProcessTable* table, int use_deadline,
+                    const PeriodicResume* state) {
+    size_t len = strlen(path);
+    char* tmp_path = malloc(len + 5);
+    memcpy(tmp_path, path, len);
+    memcpy(tmp_path + len, ".tmp", 5);
+
+    FILE* file = fopen(tmp_path, "wb");
+    if (!file) {
+        perror("Erro ao criar checkpoint");
+        free(tmp_path);
+        return -1;
+    }
+
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.tasks = table->size;
+    header.use_deadline = use_deadline;
+    header.workload = workload_fingerprint(table);
+    header.time = state->time;
+    header.cpu_time = state->cpu_time;
+    header.clock = state->clock;
+    save_default_rng(&header.rng);
+
+    size_t n = table->size;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(table->remaining, sizeof(int), n, file) == n &&
+             fwrite(table->next_release, sizeof(int), n, file) == n &&
+             fwrite(table->misses, sizeof(long long), n, file) == n;
+    if (fclose(file) != 0) ok = 0;
+    if (ok && rename(tmp_path, path) != 0) ok = 0;
+    if (!ok) {
+        perror("Erro ao escrever checkpoint");
+        remove(tmp_path);
+    }
+    free(tmp_path);
+    return ok ? 0 : -1;
+}
+
+int load_checkpoint(const char* path, ProcessTable* table, int use_deadline,
+                    PeriodicResume* state) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror("Erro ao abrir checkpoint");
+        return -1;
+    }
+
+    CheckpointHeader header;
+    size_t n = table->size;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        fprintf(stderr, "Erro: %s: checkpoint inválido\n", path);
+        fclose(file);
+        return -1;
+    }
+    if (header.tasks != n || header.workload != workload_fingerprint(table) ||
+        header.use_deadline != (uint32_t)use_deadline) {
+        fprintf(stderr, "Erro: %s: checkpoint de outra carga ou algoritmo\n", path);
+        fclose(file);
+        return -1;
+    }
+
+    int ok = fread(table->remaining, sizeof(int), n, file) == n &&
+             fread(table->next_release, sizeof(int), n, file) == n &&
+             fread(table->misses, sizeof(long long), n, file) == n;
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "Erro: %s: checkpoint truncado\n", path);
+        return -1;
+    }
+
+    state->time = header.time;
+    state->clock = header.clock;
+    state->cpu_time = header.cpu_time;
+    restore_default_rng(&header.rng);
+    return 0;
+}
+
+static void request_stop(int sig) {
+    (void)sig;
+    periodic_stop_requested = 1;
+}
+
+void install_checkpoint_signals(void) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = request_stop;
+    action.sa_flags = SA_RESETHAND;   // o segundo sinal tem o efeito normal
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+}
@@ -0,0 +1,100 @@
+#include <stdlib.h>
+#include "heap.h"
+
+ReadyHeap* create_ready_heap(Arena* arena, int capacity) {
+    ReadyHeap* heap = arena_alloc(arena, sizeof(ReadyHeap));
+    heap->nodes = arena_alloc(arena, sizeof(HeapNode) * (capacity > 0 ? capacity : 1));
+    heap->pos = arena_alloc(arena, sizeof(int) * (capacity > 0 ? capacity : 1));
+    for (int i = 0; i < capacity; i++)
+        heap->pos[i] = -1;
+    heap->size = 0;
+    heap->capacity = capacity;
+    heap->arena = arena;
+    return heap;
+}
+
+static int node_less(HeapNode a, HeapNode b) {
+    return a.key < b.key || (a.key == b.key && a.id < b.id);
+}
+
+static void sift_up(ReadyHeap* heap, int i) {
+    HeapNode node = heap->nodes[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!node_less(node, heap->nodes[parent])) break;
+        heap->nodes[i] = heap->nodes[parent];
+        heap->pos[heap->nodes[i].id] = i;
+        i = parent;
+    }
+    heap->nodes[i] = node;
+    heap->pos[node.id] = i;
+}
+
+static void sift_down(ReadyHeap* heap, int i) {
+    HeapNode node = heap->nodes[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= heap->size) break;
+        if (child + 1 < heap->size && node_less(heap->nodes[child + 1], heap->nodes[child]))
+            child++;
+        if (!node_less(heap->nodes[child], node)) break;
+        heap->nodes[i] = heap->nodes[child];
+        heap->pos[heap->nodes[i].id] = i;
+        i = child;
+    }
+    heap->nodes[i] = node;
+    heap->pos[node.id] = i;
+}
+
+// Garante espaço para ids até id (a fila de jobs vivos pode crescer)
+static void heap_grow(ReadyHeap* heap, int id) {
+    int capacity = heap->capacity > 0 ? heap->capacity : 1;
+    while (capacity <= id) capacity *= 2;
+    heap->nodes = arena_grow(heap->arena, heap->nodes, sizeof(HeapNode) * heap->capacity, sizeof(HeapNode) * capacity);
+    heap->pos = arena_grow(heap->arena, heap->pos, sizeof(int) * heap->capacity, sizeof(int) * capacity);
+    for (int i = heap->capacity; i < capacity; i++)
+        heap->pos[i] = -1;
+    heap->capacity = capacity;
+}
+
+void heap_push(ReadyHeap* heap, int id, long long key) {
+    if (id >= heap->capacity) heap_grow(heap, id);
+    int i = heap->size++;
+    heap->nodes[i].key = key;
+    heap->nodes[i].id = id;
+    sift_up(heap, i);
+}
+
+int heap_pop(ReadyHeap* heap) {
+    if (heap->size == 0) return -1;
+    int id = heap->nodes[0].id;
+    heap_remove(heap, id);
+    return id;
+}
+
+// Altera a chave de um elemento (diminuir ou aumentar); insere se não existir
+void heap_update(ReadyHeap* heap, int id, long long key) {
+    int i = id < heap->capacity ? heap->pos[id] : -1;
+    if (i < 0) {
+        heap_push(heap, id, key);
+        return;
+    }
+    long long old = heap->nodes[i].key;
+    heap->nodes[i].key = key;
+    if (key < old) sift_up(heap, i);
+    else sift_down(heap, i);
+}
+
+void heap_remove(ReadyHeap* heap, int id) {
+    if (id >= heap->capacity) return;
+    int i = heap->pos[id];
+    if (i < 0) return;
+    heap->pos[id] = -1;
+    heap->size--;
+    if (i == heap->size) return;
+    HeapNode moved = heap->nodes[heap->size];
+    heap->nodes[i] = moved;
+    heap->pos[moved.id] = i;
+    sift_up(heap, i);
+    sift_down(heap, heap->pos[moved.id]);
+}
@@ -0,0 +1,93 @@
+#include <string.h>
+#include <limits.h>
+#include "histogram.h"
+#include "output.h"
+
+void hist_init(Histogram* h) {
+    memset(h->counts, 0, sizeof(h->counts));
+    h->lowest = 2 * HIST_BUCKETS;
+    h->highest = -1;
+    h->total = 0;
+    h->sum = 0;
+    h->min = LLONG_MAX;
+    h->max = LLONG_MIN;
+}
+
+void hist_merge(Histogram* into, const Histogram* from) {
+    for (int i = from->lowest; i <= from->highest; i++)
+        into->counts[i] += from->counts[i];
+    if (from->lowest < into->lowest) into->lowest = from->lowest;
+    if (from->highest > into->highest) into->highest = from->highest;
+    if (from->min < into->min) into->min = from->min;
+    if (from->max > into->max) into->max = from->max;
+    into->total += from->total;
+    into->sum += from->sum;
+}
+
+void hist_copy(Histogram* dst, const Histogram* src) {
+    for (int i = src->lowest; i <= src->highest; i++)
+        dst->counts[i] = src->counts[i];
+    dst->lowest = src->lowest;
+    dst->highest = src->highest;
+    dst->total = src->total;
+    dst->sum = src->sum;
+    dst->min = src->min;
+    dst->max = src->max;
+}
+
+// Os baldes de h contêm os de since (h é since com mais registos), e os
+// valores repetidos não mudam o mínimo nem o máximo
+void hist_repeat_since(Histogram* h, const Histogram* since, long long times) {
+    for (int i = h->lowest; i <= h->highest; i++) {
+        uint64_t before = i >= since->lowest && i <= since->highest ? since->counts[i] : 0;
+        h->counts[i] += (uint64_t)times * (h->counts[i] - before);
+    }
+    h->total += (uint64_t)times * (h->total - since->total);
+    h->sum += times * (h->sum - since->sum);
+}
+
+// Limite superior dos valores do balde i (em módulo)
+static long long bucket_high(int i) {
+    if (i < 2 * HIST_HALF) return i;
+    int shift = i / HIST_HALF - 1;
+    long long m = i - shift * HIST_HALF;
+    return ((m + 1) << shift) - 1;
+}
+
+static long long bucket_low(int i) {
+    if (i < 2 * HIST_HALF) return i;
+    int shift = i / HIST_HALF - 1;
+    return (long long)(i - shift * HIST_HALF) << shift;
+}
+
+Percentiles hist_percentiles(const Histogram* h) {
+    Percentiles p = { (long long)h->total, 0, 0, 0, 0, h->total ? h->max : 0 };
+    if (!h->total) return p;
+
+    static const double quantiles[4] = { 0.5, 0.9, 0.99, 0.999 };
+    long long* out[4] = { &p.p50, &p.p90, &p.p99, &p.p999 };
+    uint64_t seen = 0;
+    int q = 0;
+    for (int i = h->lowest; i <= h->highest && q < 4; i++) {
+        seen += h->counts[i];
+        while (q < 4) {
+            double exact = quantiles[q] * h->total;
+            uint64_t rank = (uint64_t)exact;
+            if (rank < exact || rank < 1) rank++;
+            if (seen < rank) break;
+            // Negativos: o limite superior é o menor módulo do balde
+            long long value = i >= HIST_BUCKETS ? bucket_high(i - HIST_BUCKETS)
+                                                : -bucket_low(HIST_BUCKETS - 1 - i);
+            if (value > h->max) value = h->max;
+            if (value < h->min) value = h->min;
+            *out[q++] = value;
+        }
+    }
+    return p;
+}
+
+void log_percentiles(const char* label, const Percentiles* p) {
+    if (p->count == 0) return;
+    LOG("%s p50/p90/p99/p99.9/max: %lld / %lld / %lld / %lld / %lld\n",
+        label, p->p50, p->p90, p->p99, p->p999, p->max);
+}
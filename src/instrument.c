@@ -0,0 +1,45 @@
+#include "instrument.h"
+
+#ifdef PROBSCHED_INSTRUMENT
+#include <string.h>
+#include "output.h"
+
+_Thread_local Instrumentation instrumentation;
+
+static const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "release", "select", "aging", "account", "output", "generate"
+};
+
+static const char* const COUNTER_NAMES[COUNTER_COUNT] = {
+    "scans", "select_iterations", "preemptions", "context_switches", "idle_ticks", "rng_draws"
+};
+
+void instrument_merge(const Instrumentation* from) {
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        instrumentation.cycles[p] += from->cycles[p];
+        instrumentation.laps[p] += from->laps[p];
+    }
+    for (int c = 0; c < COUNTER_COUNT; c++)
+        instrumentation.counters[c] += from->counters[c];
+}
+
+// Escreve o bloco JSON da execução e recomeça a contagem; a geração da carga
+// antes da execução conta na execução seguinte
+void instrument_report(const char* run) {
+    if (verbosity >= VERBOSITY_SUMMARY) {
+        out_printf("{\"instrumentation\": {\"run\": \"%s\", \"clock\": \"%s\",\n", run, INSTR_CLOCK_UNIT);
+        out_printf("  \"phases\": {");
+        for (int p = 0; p < PHASE_COUNT; p++)
+            out_printf("%s\"%s\": {\"cycles\": %llu, \"laps\": %llu}", p ? ", " : "", PHASE_NAMES[p],
+                       (unsigned long long)instrumentation.cycles[p],
+                       (unsigned long long)instrumentation.laps[p]);
+        out_printf("},\n  \"counters\": {");
+        for (int c = 0; c < COUNTER_COUNT; c++)
+            out_printf("%s\"%s\": %llu", c ? ", " : "", COUNTER_NAMES[c],
+                       (unsigned long long)instrumentation.counters[c]);
+        out_printf("}}}\n");
+    }
+    memset(&instrumentation, 0, sizeof(instrumentation));
+}
+
+#endif
@@ -1,9 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <time.h>
 #include "process.h"
 #include "scheduler.h"
+#include "sweep.h"
+#include "bench.h"
+#include "multiproc.h"
+#include "analysis.h"
+#include "output.h"
+#include "arena.h"
+#include "trace.h"
 
 SchedulingAlgorithm parse_algo(const char* str) {
     if (strcmp(str, "FCFS") == 0) return FCFS;
@@ -13,53 +21,388 @@ SchedulingAlgorithm parse_algo(const char* str) {
     if (strcmp(str, "RR") == 0) return ROUND_ROBIN;
     if (strcmp(str, "RM") == 0) return RATE_MONOTONIC;
     if (strcmp(str, "EDF") == 0) return EDF;
+    if (strcmp(str, "CFS") == 0) return CFS;
+    if (strcmp(str, "MLFQ") == 0) return MLFQ;
     return FCFS;
 }
 
+const char* algo_name(SchedulingAlgorithm algo) {
+    switch (algo) {
+        case FCFS: return "FCFS";
+        case SJF: return "SJF";
+        case PRIORITY_NON_PREEMPTIVE: return "PRIORITY";
+        case PRIORITY_PREEMPTIVE: return "PPRIO";
+        case ROUND_ROBIN: return "RR";
+        case RATE_MONOTONIC: return "RM";
+        case EDF: return "EDF";
+        case CFS: return "CFS";
+        case MLFQ: return "MLFQ";
+    }
+    return "?";
+}
+
+// Lista de algoritmos separados por vírgulas, ou ALL
+static int parse_algo_list(const char* str, SchedulingAlgorithm** out) {
+    SchedulingAlgorithm all[] = { FCFS, SJF, PRIORITY_NON_PREEMPTIVE, PRIORITY_PREEMPTIVE,
+                                  ROUND_ROBIN, CFS, MLFQ, RATE_MONOTONIC, EDF };
+    int num_all = sizeof(all) / sizeof(all[0]);
+    int count = 0;
+    SchedulingAlgorithm* algos = malloc(sizeof(SchedulingAlgorithm) * (strlen(str) / 2 + num_all));
+    if (strcmp(str, "ALL") == 0) {
+        for (int i = 0; i < num_all; i++)
+            algos[count++] = all[i];
+    } else {
+        char* names = strdup(str);
+        for (char* tok = strtok(names, ","); tok; tok = strtok(NULL, ","))
+            algos[count++] = parse_algo(tok);
+        free(names);
+    }
+    *out = algos;
+    return count;
+}
+
+// Modo SWEEP: SWEEP <ALGOS|ALL> <SEEDS> <QUANTA> <N_PROCESSOS> [CSV|JSONL] [THREADS]
+// ALGOS separados por vírgulas; SEEDS e QUANTA como "1-100" ou "2,4,8"
+static int run_sweep_mode(int argc, char* argv[]) {
+    if (argc < 6) {
+        printf("Uso: %s SWEEP <ALGOS|ALL> <SEEDS> <QUANTA> <N_PROCESSOS> [CSV|JSONL] [THREADS]\n", argv[0]);
+        return 1;
+    }
+
+    SweepConfig config = { 0 };
+    config.num_algos = parse_algo_list(argv[2], &config.algos);
+
+    config.num_seeds = parse_int_list(argv[3], &config.seeds);
+    config.num_quanta = parse_int_list(argv[4], &config.quanta);
+    config.num_processes = atoi(argv[5]);
+    config.jsonl = argc >= 7 && strcmp(argv[6], "JSONL") == 0;
+    config.threads = argc >= 8 ? atoi(argv[7]) : 0;
+
+    int valid = config.num_algos > 0 && config.num_seeds > 0 && config.num_quanta > 0 && config.num_processes > 0;
+    // Com um quantum <= 0 o RR e o MLFQ nunca avançam o tempo; os outros
+    // algoritmos ignoram os quanta
+    for (int a = 0; valid && a < config.num_algos; a++) {
+        if (!uses_quantum(config.algos[a])) continue;
+        for (int q = 0; valid && q < config.num_quanta; q++)
+            valid = config.quanta[q] > 0;
+    }
+    if (!valid) {
+        printf("Erro: Parâmetros de varrimento inválidos!\n");
+        return 1;
+    }
+
+    run_sweep(&config, stdout);
+
+    free(config.algos);
+    free(config.seeds);
+    free(config.quanta);
+    return 0;
+}
+
+// Modo BENCH: BENCH <ALGOS|ALL> <N_PROCESSOS> <HORIZONTES> [FICHEIRO_CSV] [QUANTUM] [BURST_MEDIO]
+// N_PROCESSOS e HORIZONTES como no SWEEP ("1000,10000"); mede cada
+// combinação sem saída dos escalonadores
+static int run_bench_mode(int argc, char* argv[]) {
+    if (argc < 5) {
+        printf("Uso: %s BENCH <ALGOS|ALL> <N_PROCESSOS> <HORIZONTES> [FICHEIRO_CSV] [QUANTUM] [BURST_MEDIO]\n", argv[0]);
+        return 1;
+    }
+
+    BenchConfig config = { 0 };
+    config.num_algos = parse_algo_list(argv[2], &config.algos);
+    config.num_sizes = parse_int_list(argv[3], &config.sizes);
+    config.num_horizons = parse_int_list(argv[4], &config.horizons);
+    config.quantum = argc >= 7 ? atoi(argv[6]) : 2;
+    config.seed = 1;
+    config.mean_burst = argc >= 8 ? atof(argv[7]) : BENCH_BURST;
+
+    int valid = config.num_algos > 0 && config.num_sizes > 0 && config.num_horizons > 0 && config.quantum > 0 &&
+                config.mean_burst >= 1;
+    for (int i = 0; i < config.num_sizes; i++)
+        if (config.sizes[i] <= 0) valid = 0;
+    for (int i = 0; i < config.num_horizons; i++)
+        if (config.horizons[i] <= 0) valid = 0;
+
+    FILE* csv = NULL;
+    if (valid && argc >= 6 && !(csv = fopen(argv[5], "w"))) {
+        perror("Erro ao criar ficheiro CSV");
+        valid = 0;
+    }
+    if (valid) run_bench(&config, csv);
+    else printf("Erro: Parâmetros do modo BENCH inválidos!\n");
+
+    if (csv) fclose(csv);
+    free(config.algos);
+    free(config.sizes);
+    free(config.horizons);
+    return valid ? 0 : 1;
+}
+
+// Modo GENERATE: GENERATE <N_PROCESSOS> <SEED> <FICHEIRO>
+// Grava uma carga gerada no formato binário, para ser carregada com --input
+static int run_generate_mode(int argc, char* argv[]) {
+    if (argc < 5) {
+        printf("Uso: %s GENERATE <N_PROCESSOS> <SEED> <FICHEIRO>\n", argv[0]);
+        return 1;
+    }
+
+    int num_processes = atoi(argv[2]);
+    if (num_processes <= 0) {
+        printf("Erro: Número de processos inválido!\n");
+        return 1;
+    }
+
+    ProcessQueue* queue = create_process_queue(num_processes);
+    ProcessGenerator gen;
+    int saved_verbosity = verbosity;
+    verbosity = VERBOSITY_QUIET;
+    init_process_generator(&gen, atoi(argv[3]));
+    generate_processes(&gen, queue, num_processes);
+    verbosity = saved_verbosity;
+
+    int status = save_processes_binary(queue, argv[4]);
+    destroy_process_queue(queue);
+    return status == 0 ? 0 : 1;
+}
+
+// Modo MULTI: <RM|EDF> MULTI <TEMPO> <CPUS> <GLOBAL|FF|WF> [THREADS]
+// Carrega as tarefas como o STATIC e simula-as em CPUS processadores
+static int run_multi_mode(int argc, char* argv[], const char* input_path) {
+    if (argc < 6) {
+        out_printf("Uso: %s <RM|EDF> MULTI <TEMPO> <CPUS> <GLOBAL|FF|WF> [THREADS]\n", argv[0]);
+        out_printf("     %s <RM|EDF> ANALYZE [TEMPO]\n", argv[0]);
+        out_printf("     %s <RM|EDF> STATIC <TEMPO> [--checkpoint=FICHEIRO] [--resume=FICHEIRO] [--checkpoint-at=TEMPO]\n", argv[0]);
+        return 1;
+    }
+
+    SchedulingAlgorithm algo = parse_algo(argv[1]);
+    long long tempo_total = atoll(argv[3]);
+    MultiprocConfig config;
+    config.cpus = atoi(argv[4]);
+    config.policy = parse_multiproc_policy(argv[5]);
+    config.threads = argc >= 7 ? atoi(argv[6]) : 0;
+
+    if ((algo != RATE_MONOTONIC && algo != EDF) || tempo_total <= 0 || config.cpus <= 0 || (int)config.policy < 0) {
+        out_printf("Erro: Parâmetros do modo MULTI inválidos!\n");
+        return 1;
+    }
+
+    ProcessQueue* queue = create_process_queue(10);
+    if (load_processes_from_file(queue, input_path) <= 0) {
+        out_printf("Erro: Nenhum processo carregado de %s!\n", input_path);
+        destroy_process_queue(queue);
+        return 1;
+    }
+
+    run_multiprocessor(queue, algo, tempo_total, &config);
+    destroy_process_queue(queue);
+    return 0;
+}
+
+// Modo ANALYZE: <RM|EDF> ANALYZE [TEMPO]
+// Testes analíticos sobre as tarefas carregadas; se o veredicto for
+// inconclusivo e houver TEMPO, recorre à simulação do STATIC
+static int run_analyze_mode(int argc, char* argv[], const char* input_path) {
+    SchedulingAlgorithm algo = parse_algo(argv[1]);
+    long long tempo_total = argc >= 4 ? atoll(argv[3]) : 0;
+    if ((algo != RATE_MONOTONIC && algo != EDF) || tempo_total < 0) {
+        out_printf("Uso: %s <RM|EDF> ANALYZE [TEMPO]\n", argv[0]);
+        return 1;
+    }
+
+    ProcessQueue* queue = create_process_queue(10);
+    if (load_processes_from_file(queue, input_path) <= 0) {
+        out_printf("Erro: Nenhum processo carregado de %s!\n", input_path);
+        destroy_process_queue(queue);
+        return 1;
+    }
+
+    struct timespec start, stop;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    SchedAnalysis analysis = algo == EDF ? analyze_edf(queue) : analyze_rm(queue);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    LOG("Tempo de análise: %.1f us\n",
+        (stop.tv_sec - start.tv_sec) * 1e6 + (stop.tv_nsec - start.tv_nsec) / 1e3);
+
+    if (analysis.verdict == INCONCLUSIVE && tempo_total > 0) {
+        LOG("Análise inconclusiva: a simular %lld ticks\n", tempo_total);
+        if (algo == EDF) run_edf_static(queue, tempo_total);
+        else run_rm_static(queue, tempo_total);
+    }
+
+    destroy_process_queue(queue);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    // Opções --verbosity=<QUIET|SUMMARY|JOBS|TIMELINE>, --input=<FICHEIRO>,
+    // --huge-pages (arenas das execuções em páginas de 2 MiB),
+    // --cfs-latency=<TICKS> e --cfs-granularity=<TICKS>, --mlfq-levels=<N>,
+    // --mlfq-quanta=<Q0,Q1,...> e --mlfq-boost=<TICKS>, para STREAM
+    // --trace=<FICHEIRO|-> e --trace-tick=<US> e, para RM/EDF STATIC,
+    // --checkpoint=<FICHEIRO>, --resume=<FICHEIRO> e --checkpoint-at=<TEMPO>
+    // podem aparecer em qualquer posição
+    const char* input_path = "data/example_input.txt";
+    const char* trace_path = NULL;
+    int trace_tick = 1000;
+    const char* mlfq_quanta_list = NULL;
+    CheckpointConfig checkpoint = { NULL, NULL, 0 };
+    int argn = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--verbosity=", 12) == 0)
+            verbosity = parse_verbosity(argv[i] + 12);
+        else if (strncmp(argv[i], "--input=", 8) == 0)
+            input_path = argv[i] + 8;
+        else if (strncmp(argv[i], "--checkpoint=", 13) == 0)
+            checkpoint.save_path = argv[i] + 13;
+        else if (strncmp(argv[i], "--resume=", 9) == 0)
+            checkpoint.resume_path = argv[i] + 9;
+        else if (strncmp(argv[i], "--checkpoint-at=", 16) == 0)
+            checkpoint.stop_at = atoll(argv[i] + 16);
+        else if (strcmp(argv[i], "--huge-pages") == 0)
+            arena_huge_pages = 1;
+        else if (strncmp(argv[i], "--cfs-latency=", 14) == 0)
+            cfs_tunables.target_latency = atoi(argv[i] + 14);
+        else if (strncmp(argv[i], "--cfs-granularity=", 18) == 0)
+            cfs_tunables.min_granularity = atoi(argv[i] + 18);
+        else if (strncmp(argv[i], "--mlfq-levels=", 14) == 0)
+            mlfq_tunables.levels = atoi(argv[i] + 14);
+        else if (strncmp(argv[i], "--mlfq-quanta=", 14) == 0)
+            mlfq_quanta_list = argv[i] + 14;
+        else if (strncmp(argv[i], "--mlfq-boost=", 13) == 0)
+            mlfq_tunables.boost_period = atoi(argv[i] + 13);
+        else if (strncmp(argv[i], "--trace=", 8) == 0)
+            trace_path = argv[i] + 8;
+        else if (strncmp(argv[i], "--trace-tick=", 13) == 0)
+            trace_tick = atoi(argv[i] + 13);
+        else
+            argv[argn++] = argv[i];
+    }
+    argc = argn;
+    if (cfs_tunables.target_latency <= 0 || cfs_tunables.min_granularity <= 0) {
+        out_printf("Erro: Parâmetros do CFS inválidos!\n");
+        return 1;
+    }
+    if (mlfq_quanta_list) {
+        // A lista de quanta dá também o número de níveis
+        int* quanta;
+        int count = parse_int_list(mlfq_quanta_list, &quanta);
+        int valid = count > 0 && count <= MLFQ_MAX_LEVELS;
+        for (int l = 0; valid && l < count; l++) {
+            valid = quanta[l] > 0;
+            mlfq_tunables.quanta[l] = quanta[l];
+        }
+        free(quanta);
+        if (!valid) mlfq_tunables.levels = 0;
+        else mlfq_tunables.levels = count;
+    }
+    if (mlfq_tunables.levels < 1 || mlfq_tunables.levels > MLFQ_MAX_LEVELS || mlfq_tunables.boost_period < 0) {
+        out_printf("Erro: Parâmetros do MLFQ inválidos!\n");
+        return 1;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "SWEEP") == 0)
+        return run_sweep_mode(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "BENCH") == 0)
+        return run_bench_mode(argc, argv);
+    if (argc >= 2 && strcmp(argv[1], "GENERATE") == 0)
+        return run_generate_mode(argc, argv);
+    if (argc >= 3 && strcmp(argv[2], "MULTI") == 0)
+        return run_multi_mode(argc, argv, input_path);
+    if (argc >= 3 && strcmp(argv[2], "ANALYZE") == 0)
+        return run_analyze_mode(argc, argv, input_path);
+
     int seed = (int)time(NULL);  // valor padrão se nenhuma seed for passada
     if (argc >= 6) {
         seed = atoi(argv[5]);
     }
-    srand(seed);
-    printf("Seed usada: %d\n", seed);
+    out_printf("Seed usada: %d\n", seed);
 
     if (argc < 3) {
-        printf("Uso: %s <ALGO> <STATIC|DYNAMIC> [argumentos adicionais]\n", argv[0]);
+        out_printf("Uso: %s <ALGO> <STATIC|DYNAMIC|STREAM> [argumentos adicionais] [--verbosity=QUIET|SUMMARY|JOBS|TIMELINE] [--input=FICHEIRO]\n", argv[0]);
+        out_printf("     %s <ALGO> STREAM [N_PROCESSOS] [QUANTUM] --trace=FICHEIRO [--trace-tick=US]\n", argv[0]);
+        out_printf("     %s SWEEP <ALGOS|ALL> <SEEDS> <QUANTA> <N_PROCESSOS> [CSV|JSONL] [THREADS]\n", argv[0]);
+        out_printf("     %s GENERATE <N_PROCESSOS> <SEED> <FICHEIRO>\n", argv[0]);
+        out_printf("     %s BENCH <ALGOS|ALL> <N_PROCESSOS> <HORIZONTES> [FICHEIRO_CSV] [QUANTUM] [BURST_MEDIO]\n", argv[0]);
+        out_printf("     %s <RM|EDF> MULTI <TEMPO> <CPUS> <GLOBAL|FF|WF> [THREADS]\n", argv[0]);
         return 1;
     }
 
     SchedulingAlgorithm algo = parse_algo(argv[1]);
     int is_dynamic = strcmp(argv[2], "DYNAMIC") == 0;
 
+    if (strcmp(argv[2], "STREAM") == 0 && trace_path) {
+        // Jobs lidos de um trace real do kernel à medida que chegam; sem
+        // N_PROCESSOS (ou com 0) o trace é lido até ao fim
+        long long num_processes = (argc >= 4) ? atoll(argv[3]) : 0;
+        int quantum = (argc >= 5) ? atoi(argv[4]) : 2;
+        if (num_processes < 0 || trace_tick <= 0) {
+            out_printf("Erro: Parâmetros do trace inválidos!\n");
+            return 1;
+        }
+        if (algo == RATE_MONOTONIC || algo == EDF) {
+            out_printf("Erro: Os jobs de um trace não são periódicos (RM/EDF)!\n");
+            return 1;
+        }
+
+        TraceReader* trace = open_trace(trace_path, trace_tick);
+        if (!trace) return 1;
+        ProcessStream* stream = create_trace_stream(trace, num_processes);
+        run_scheduler_stream(stream, algo, quantum);
+        log_trace_summary(trace);
+        destroy_process_stream(stream);
+        close_trace(trace);
+        return 0;
+    }
+
+    if (strcmp(argv[2], "STREAM") == 0) {
+        // Como o DYNAMIC, mas os processos são gerados à medida que chegam
+        // e retirados ao terminar; o total pode exceder a memória disponível
+        long long num_processes = (argc >= 4) ? atoll(argv[3]) : 5;
+        if (num_processes <= 0 || num_processes > INT_MAX) {
+            out_printf("Erro: Número de processos inválido!\n");
+            return 1;
+        }
+        int quantum = (argc >= 5) ? atoi(argv[4]) : 2;
+
+        ProcessStream* stream = create_process_stream(seed, num_processes);
+        run_scheduler_stream(stream, algo, quantum);
+        destroy_process_stream(stream);
+        return 0;
+    }
+
     ProcessQueue* queue = create_process_queue(10);
 
     if (is_dynamic) {
         // Se fornecido, o número de processos é o 4º argumento
         int num_processes = (argc >= 4) ? atoi(argv[3]) : 5;
         if (num_processes <= 0) {
-            printf("Erro: Número de processos inválido!\n");
+            out_printf("Erro: Número de processos inválido!\n");
             return 1;
         }
 
-        for (int i = 0; i < num_processes; i++) {
-            add_process(queue, generate_random_process(i + 1, i * 2));
-        }
+        ProcessGenerator gen;
+        init_process_generator(&gen, seed);
+        generate_processes(&gen, queue, num_processes);
 
     } else {  // STATIC mode
         if (argc < 4) {
-            printf("Erro: No modo STATIC, forneça o tempo máximo de simulação!\n");
+            out_printf("Erro: No modo STATIC, forneça o tempo máximo de simulação!\n");
             return 1;
         }
 
-        int max_simulation_time = atoi(argv[3]);
+        long long max_simulation_time = atoll(argv[3]);
         if (max_simulation_time <= 0) {
-            printf("Erro: Tempo máximo de simulação inválido!\n");
+            out_printf("Erro: Tempo máximo de simulação inválido!\n");
             return 1;
         }
 
-        load_processes_from_file(queue);
-        printf("Tempo máximo de simulação: %d\n", max_simulation_time);
+        if (load_processes_from_file(queue, input_path) <= 0) {
+            out_printf("Erro: Nenhum processo carregado de %s!\n", input_path);
+            destroy_process_queue(queue);
+            return 1;
+        }
+        out_printf("Tempo máximo de simulação: %lld\n", max_simulation_time);
     }
 
     // O quantum pode ser usado tanto no modo estático quanto no dinâmico (mas é essencial para o Round Robin)
@@ -68,8 +411,14 @@ int main(int argc, char* argv[]) {
     if (is_dynamic) {
         run_scheduler(queue, algo, quantum);
     } else {
-        int tempo_total = atoi(argv[3]);  // Tempo máximo de simulação já passado como argumento no STATIC
-        run_scheduler_static(queue, algo, quantum, tempo_total);
+        long long tempo_total = atoll(argv[3]);  // Tempo máximo de simulação já passado como argumento no STATIC
+        if (checkpoint.save_path || checkpoint.resume_path) {
+            // Com um checkpoint a gravar, Ctrl-C pára a simulação e grava-o
+            if (checkpoint.save_path) install_checkpoint_signals();
+            run_periodic_checkpointed(queue, algo, tempo_total, &checkpoint);
+        } else {
+            run_scheduler_static(queue, algo, quantum, tempo_total);
+        }
     }
 
     destroy_process_queue(queue);
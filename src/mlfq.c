@@ -0,0 +1,74 @@
+#include "mlfq.h"
+
+// Índice de um anel vazio: um reaproveitado ou um novo
+static int take_ring(MlfqQueues* q, int capacity) {
+    if (q->spare->size) return ring_pop(q->spare);
+    if (q->num_rings == q->rings_capacity) {
+        int old = q->rings_capacity;
+        q->rings_capacity *= 2;
+        q->rings = arena_grow(q->arena, q->rings, sizeof(RingQueue*) * old,
+                              sizeof(RingQueue*) * q->rings_capacity);
+    }
+    q->rings[q->num_rings] = create_ring_queue(q->arena, capacity);
+    return q->num_rings++;
+}
+
+MlfqQueues* create_mlfq_queues(Arena* arena, int levels, int capacity) {
+    MlfqQueues* q = arena_alloc(arena, sizeof(MlfqQueues));
+    q->levels = levels;
+    q->arena = arena;
+    q->num_rings = 0;
+    q->rings_capacity = 2 * levels;
+    q->rings = arena_alloc(arena, sizeof(RingQueue*) * q->rings_capacity);
+    q->top = create_ring_queue(arena, levels);
+    q->spare = create_ring_queue(arena, levels);
+    for (int l = 0; l < levels; l++) {
+        q->level[l] = take_ring(q, capacity);
+        q->size[l] = 0;
+    }
+    ring_push(q->top, q->level[0]);
+    q->bitmap = 0;
+    return q;
+}
+
+int mlfq_pop(MlfqQueues* q, int* level) {
+    if (!q->bitmap) {
+        *level = -1;
+        return -1;
+    }
+    int l = __builtin_ctz(q->bitmap);
+    RingQueue* ring = q->rings[q->level[l]];
+    if (l == 0) {
+        // Os anéis da frente do nível 0 que já esvaziaram ficam livres; o
+        // último (onde se insere) nunca sai, e o nível não está vazio
+        ring = q->rings[q->top->items[q->top->head]];
+        while (ring->size == 0) {
+            ring_push(q->spare, ring_pop(q->top));
+            ring = q->rings[q->top->items[q->top->head]];
+        }
+    }
+    int id = ring_pop(ring);
+    if (--q->size[l] == 0) q->bitmap &= ~(1u << l);
+    *level = l;
+    return id;
+}
+
+void mlfq_boost(MlfqQueues* q) {
+    for (int l = 1; l < q->levels; l++) {
+        if (!q->size[l]) continue;
+        RingQueue** back = &q->rings[q->level[0]];
+        if ((*back)->size == 0) {
+            // O último anel do nível 0 está vazio: troca-o pelo do nível l
+            RingQueue* empty = *back;
+            *back = q->rings[q->level[l]];
+            q->rings[q->level[l]] = empty;
+        } else {
+            ring_push(q->top, q->level[l]);
+            q->level[0] = q->level[l];
+            q->level[l] = take_ring(q, 16);
+        }
+        q->size[0] += q->size[l];
+        q->size[l] = 0;
+    }
+    q->bitmap = q->size[0] ? 1 : 0;
+}
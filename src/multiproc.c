@@ -0,0 +1,271 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "multiproc.h"
+#include "periodic.h"
+#include "pool.h"
+#include "output.h"
+#include "instrument.h"
+#include "arena.h"
+
+int parse_multiproc_policy(const char* str) {
+    if (strcmp(str, "GLOBAL") == 0) return MP_GLOBAL;
+    if (strcmp(str, "FF") == 0) return MP_FIRST_FIT;
+    if (strcmp(str, "WF") == 0) return MP_WORST_FIT;
+    return -1;
+}
+
+// Utilização de uma tarefa; sem período conta como um processador inteiro
+static double task_utilization(const Process* p) {
+    return p->period > 0 ? (double)p->burst_time / p->period : 1.0;
+}
+
+// Limite de admissão de uma partição com k tarefas: 1 no EDF (exato), o de
+// Liu & Layland no RM (suficiente)
+static double admission_bound(int use_deadline, int k) {
+    return use_deadline ? 1.0 : k * (pow(2.0, 1.0 / k) - 1.0);
+}
+
+typedef struct {
+    int index;
+    double utilization;
+} TaskLoad;
+
+// Utilização decrescente; empates pela ordem original
+static int compare_load(const void* a, const void* b) {
+    const TaskLoad* x = a;
+    const TaskLoad* y = b;
+    if (x->utilization != y->utilization) return x->utilization < y->utilization ? 1 : -1;
+    return x->index - y->index;
+}
+
+typedef struct {
+    ProcessQueue queue;     // tarefas da partição, pela ordem original
+    int tasks;
+    double utilization;
+    ProcessTable* table;
+    Timeline* timeline;
+    PeriodicResult result;
+    long long misses;
+    Histogram* response;    // da partição; juntados no fim
+    Histogram* lateness;
+#ifdef PROBSCHED_INSTRUMENT
+    Instrumentation counts;     // do worker durante a partição; somado no fim
+#endif
+} Partition;
+
+typedef struct {
+    Partition* parts;
+    long long tempo_total;
+    int use_deadline;
+    int record_timeline;
+} PartitionContext;
+
+// Atribui cada tarefa a uma partição; devolve quantas não cabiam em nenhuma
+// (essas vão para a partição menos carregada)
+static int pack_tasks(Arena* arena, const ProcessQueue* queue, Partition* parts, int cpus,
+                      MultiprocPolicy policy, int use_deadline, int* part_of) {
+    int n = queue->size;
+    int overloaded = 0;
+    TaskLoad* loads = arena_alloc(arena, sizeof(TaskLoad) * (n > 0 ? n : 1));
+    for (int i = 0; i < n; i++) {
+        loads[i].index = i;
+        loads[i].utilization = task_utilization(&queue->list[i]);
+    }
+    qsort(loads, n, sizeof(TaskLoad), compare_load);
+
+    for (int k = 0; k < n; k++) {
+        double u = loads[k].utilization;
+        int least = 0;
+        for (int c = 1; c < cpus; c++)
+            if (parts[c].utilization < parts[least].utilization) least = c;
+
+        int chosen = -1;
+        if (policy == MP_FIRST_FIT) {
+            for (int c = 0; c < cpus && chosen < 0; c++)
+                if (parts[c].utilization + u <= admission_bound(use_deadline, parts[c].tasks + 1))
+                    chosen = c;
+        } else if (parts[least].utilization + u <= admission_bound(use_deadline, parts[least].tasks + 1)) {
+            chosen = least;
+        }
+        if (chosen < 0) {
+            chosen = least;
+            overloaded++;
+        }
+        parts[chosen].utilization += u;
+        parts[chosen].tasks++;
+        part_of[loads[k].index] = chosen;
+    }
+    return overloaded;
+}
+
+// Cada partição é um uniprocessador independente: a sua tabela, a sua linha
+// temporal e nenhuma escrita na saída (feita depois, pela ordem dos CPUs).
+// A tabela vem da arena de quem chama, porque a do worker acaba com a
+// thread; o estado da simulação sai da arena do worker. A instrumentação é
+// por thread e morre com o worker, por isso cada partição guarda a sua.
+static void partition_task(void* arg, int c) {
+    PartitionContext* ctx = arg;
+    Partition* part = &ctx->parts[c];
+#ifdef PROBSCHED_INSTRUMENT
+    Instrumentation saved = instrumentation;
+    memset(&instrumentation, 0, sizeof(instrumentation));
+#endif
+    part->timeline = ctx->record_timeline ? create_timeline(64) : NULL;
+
+    PeriodicSim sim = { ctx->tempo_total, ctx->use_deadline, 1,
+                        part->timeline ? &part->timeline : NULL, 0, NULL,
+                        part->response, part->lateness };
+    part->result = simulate_periodic(part->table, &sim);
+    part->misses = 0;
+    for (int i = 0; i < part->table->size; i++)
+        part->misses += part->table->misses[i];
+#ifdef PROBSCHED_INSTRUMENT
+    part->counts = instrumentation;
+    instrumentation = saved;
+#endif
+}
+
+// Resultado agregado das partições: tempo de CPU e eventos somados, e os
+// histogramas de todas juntos em response e lateness
+static PeriodicResult run_partitioned(ProcessQueue* queue, long long tempo_total, int use_deadline,
+                                      const MultiprocConfig* config, Histogram* response,
+                                      Histogram* lateness, long long* total_misses) {
+    int cpus = config->cpus;
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    Partition* parts = arena_alloc(arena, sizeof(Partition) * cpus);
+    int* part_of = arena_alloc(arena, sizeof(int) * (queue->size > 0 ? queue->size : 1));
+    memset(parts, 0, sizeof(Partition) * cpus);
+
+    int overloaded = pack_tasks(arena, queue, parts, cpus, config->policy, use_deadline, part_of);
+    for (int c = 0; c < cpus; c++) {
+        parts[c].queue.list = arena_alloc(arena, sizeof(Process) * (parts[c].tasks > 0 ? parts[c].tasks : 1));
+        parts[c].queue.capacity = parts[c].tasks;
+    }
+    for (int i = 0; i < queue->size; i++) {
+        ProcessQueue* part_queue = &parts[part_of[i]].queue;
+        part_queue->list[part_queue->size++] = queue->list[i];
+    }
+    for (int c = 0; c < cpus; c++) {
+        parts[c].table = create_process_table(arena, &parts[c].queue);
+        parts[c].response = arena_alloc(arena, sizeof(Histogram));
+        parts[c].lateness = arena_alloc(arena, sizeof(Histogram));
+        hist_init(parts[c].response);
+        hist_init(parts[c].lateness);
+    }
+
+    PartitionContext ctx = { parts, tempo_total, use_deadline, verbosity >= VERBOSITY_TIMELINE };
+    pool_run(pool_workers(config->threads), cpus, partition_task, &ctx);
+
+    PeriodicResult total = { 0, tempo_total, -1, 0, 0, 0, 0, 0 };
+    *total_misses = 0;
+    for (int c = 0; c < cpus; c++) {
+        Partition* part = &parts[c];
+        LOG("CPU %d: %d tarefa(s), U = %.3f, %lld deadline(s) perdido(s)\n",
+            c, part->tasks, part->utilization, part->misses);
+        for (int i = 0; i < part->table->size; i++)
+            if (part->table->misses[i] > 0)
+                LOG_JOB("MISS: Processo %d perdeu %lld deadline(s)\n",
+                        part->table->id[i], part->table->misses[i]);
+        if (part->timeline) {
+            print_timeline(part->timeline);
+            destroy_timeline(part->timeline);
+        }
+        log_periodic_result(&part->result, tempo_total);
+        total.cpu_time += part->result.cpu_time;
+        total.decisions += part->result.decisions;
+        *total_misses += part->misses;
+        hist_merge(response, part->response);
+        hist_merge(lateness, part->lateness);
+#ifdef PROBSCHED_INSTRUMENT
+        instrument_merge(&part->counts);
+#endif
+    }
+    LOG("Tarefas acima do limite de admissão: %d\n", overloaded);
+
+    arena_release(arena, mark);
+    return total;
+}
+
+static PeriodicResult run_global(ProcessQueue* queue, long long tempo_total, int use_deadline,
+                                 const MultiprocConfig* config, Histogram* response,
+                                 Histogram* lateness, long long* total_misses) {
+    int cpus = config->cpus;
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    ProcessTable* table = create_process_table(arena, queue);
+    Timeline** timelines = NULL;
+    if (verbosity >= VERBOSITY_TIMELINE) {
+        timelines = malloc(sizeof(Timeline*) * cpus);
+        for (int c = 0; c < cpus; c++)
+            timelines[c] = create_timeline(64);
+    }
+
+    PeriodicSim sim = { tempo_total, use_deadline, cpus, timelines, 1, NULL, response, lateness };
+    PeriodicResult result = simulate_periodic(table, &sim);
+
+    *total_misses = 0;
+    for (int i = 0; i < table->size; i++)
+        *total_misses += table->misses[i];
+
+    if (timelines) {
+        for (int c = 0; c < cpus; c++) {
+            out_printf("CPU %d: ", c);
+            print_timeline(timelines[c]);
+            destroy_timeline(timelines[c]);
+        }
+        free(timelines);
+    }
+    log_periodic_result(&result, tempo_total);
+    arena_release(arena, mark);
+    return result;
+}
+
+SchedulerStats run_multiprocessor(ProcessQueue* queue, SchedulingAlgorithm algo,
+                                  long long tempo_total, const MultiprocConfig* config) {
+    SchedulerStats none = { 0 };
+    if (algo != RATE_MONOTONIC && algo != EDF) {
+        LOG("Algoritmo (multiprocessador) não implementado\n");
+        return none;
+    }
+
+    int use_deadline = algo == EDF;
+    const char* name = use_deadline ? "EDF" : "RM";
+    const char* mode = config->policy == MP_GLOBAL ? "Global"
+                     : config->policy == MP_FIRST_FIT ? "Particionado first-fit"
+                                                      : "Particionado worst-fit";
+    LOG("\n[%s %s] %d CPUs | Tempo limite = %lld\n", name, mode, config->cpus, tempo_total);
+
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    Histogram* response = arena_alloc(arena, sizeof(Histogram));
+    Histogram* lateness = arena_alloc(arena, sizeof(Histogram));
+    hist_init(response);
+    hist_init(lateness);
+
+    // O tempo coberto só fica abaixo do horizonte se o relógio de 32 bits não
+    // chegar e não houver regime periódico (no global; por partição é aviso)
+    long long total_misses;
+    PeriodicResult result = config->policy == MP_GLOBAL
+        ? run_global(queue, tempo_total, use_deadline, config, response, lateness, &total_misses)
+        : run_partitioned(queue, tempo_total, use_deadline, config, response, lateness, &total_misses);
+
+    float utilization = (float)result.cpu_time / ((float)result.horizon * config->cpus) * 100.0;
+    int period = queue->list[0].period;  // 0 se o ficheiro não indicar período
+    float throughput = period > 0 ? (float)(tempo_total / period) * queue->size / tempo_total : 0;
+
+    LOG("\n--- Estatísticas %s %s (%d CPUs) ---\n", name, mode, config->cpus);
+    SchedulerStats stats = { 0, 0, 0, throughput, utilization, total_misses, result.horizon, result.decisions };
+    stats.response_tail = hist_percentiles(response);
+    stats.lateness_tail = hist_percentiles(lateness);
+    LOG("Total de deadline misses: %lld\n", total_misses);
+    log_percentiles("Resposta", &stats.response_tail);
+    log_percentiles("Atraso", &stats.lateness_tail);
+    LOG("Utilização da CPU: %.2f%%\n", utilization);
+    LOG("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
+    arena_release(arena, mark);
+    // No particionado só conta o que correu na thread que chama
+    INSTR_REPORT(algo_name(algo));
+    return stats;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include "output.h"
+
+int verbosity = VERBOSITY_TIMELINE;
+
+#define OUT_BLOCK_SIZE (1 << 20)
+#define OUT_BLOCKS 8
+
+// Os blocos são usados em anel: o produtor enche o bloco submitted % N e o
+// escritor esvazia o bloco written % N. Sem a thread (pouca saída), o bloco
+// atual é escrito diretamente no flush.
+typedef struct {
+    char data[OUT_BLOCK_SIZE];
+    size_t len;
+} OutBlock;
+
+static OutBlock* blocks;
+static unsigned long submitted, written;
+static int writer_running, stopping;
+static pthread_t writer;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond_full = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t cond_free = PTHREAD_COND_INITIALIZER;
+
+static void* writer_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (written == submitted && !stopping)
+            pthread_cond_wait(&cond_full, &lock);
+        if (written == submitted) break;
+        OutBlock* block = &blocks[written % OUT_BLOCKS];
+        pthread_mutex_unlock(&lock);
+
+        fwrite(block->data, 1, block->len, stdout);
+        fflush(stdout);
+        block->len = 0;
+
+        pthread_mutex_lock(&lock);
+        written++;
+        pthread_cond_broadcast(&cond_free);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+static OutBlock* current_block(void) {
+    if (!blocks) {
+        blocks = calloc(OUT_BLOCKS, sizeof(OutBlock));
+        atexit(out_close);
+    }
+    return &blocks[submitted % OUT_BLOCKS];
+}
+
+// Entrega o bloco atual ao escritor e espera que o seguinte esteja livre
+static void submit_block(void) {
+    pthread_mutex_lock(&lock);
+    if (!writer_running) {
+        stopping = 0;
+        writer_running = pthread_create(&writer, NULL, writer_main, NULL) == 0;
+    }
+    if (!writer_running) {
+        // Sem thread: escreve de forma síncrona
+        pthread_mutex_unlock(&lock);
+        OutBlock* block = current_block();
+        fwrite(block->data, 1, block->len, stdout);
+        block->len = 0;
+        return;
+    }
+    submitted++;
+    pthread_cond_signal(&cond_full);
+    while (submitted - written >= OUT_BLOCKS)
+        pthread_cond_wait(&cond_free, &lock);
+    pthread_mutex_unlock(&lock);
+}
+
+void out_write(const char* data, size_t len) {
+    OutBlock* block = current_block();
+    while (len > 0) {
+        size_t room = OUT_BLOCK_SIZE - block->len;
+        size_t n = len < room ? len : room;
+        memcpy(block->data + block->len, data, n);
+        block->len += n;
+        data += n;
+        len -= n;
+        if (block->len == OUT_BLOCK_SIZE) {
+            submit_block();
+            block = current_block();
+        }
+    }
+}
+
+void out_printf(const char* fmt, ...) {
+    OutBlock* block = current_block();
+    size_t room = OUT_BLOCK_SIZE - block->len;
+    va_list args;
+
+    // Formata diretamente no bloco; só se não couber usa um buffer à parte
+    va_start(args, fmt);
+    int n = vsnprintf(block->data + block->len, room, fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    if ((size_t)n < room) {
+        block->len += n;
+        return;
+    }
+
+    char* text = malloc((size_t)n + 1);
+    va_start(args, fmt);
+    vsnprintf(text, (size_t)n + 1, fmt, args);
+    va_end(args);
+    out_write(text, n);
+    free(text);
+}
+
+void out_flush(void) {
+    if (!blocks) return;
+    OutBlock* block = current_block();
+    if (!writer_running) {
+        fwrite(block->data, 1, block->len, stdout);
+        block->len = 0;
+    } else {
+        pthread_mutex_lock(&lock);
+        if (block->len > 0) {
+            submitted++;
+            pthread_cond_signal(&cond_full);
+        }
+        while (written != submitted)
+            pthread_cond_wait(&cond_free, &lock);
+        pthread_mutex_unlock(&lock);
+    }
+    fflush(stdout);
+}
+
+void out_close(void) {
+    out_flush();
+    if (!writer_running) return;
+    pthread_mutex_lock(&lock);
+    stopping = 1;
+    pthread_cond_signal(&cond_full);
+    pthread_mutex_unlock(&lock);
+    pthread_join(writer, NULL);
+    writer_running = 0;
+}
+
+Verbosity parse_verbosity(const char* str) {
+    if (strcmp(str, "QUIET") == 0 || strcmp(str, "0") == 0) return VERBOSITY_QUIET;
+    if (strcmp(str, "SUMMARY") == 0 || strcmp(str, "1") == 0) return VERBOSITY_SUMMARY;
+    if (strcmp(str, "JOBS") == 0 || strcmp(str, "2") == 0) return VERBOSITY_JOBS;
+    return VERBOSITY_TIMELINE;
+}
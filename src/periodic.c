@@ -0,0 +1,339 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "periodic.h"
+#include "argmin.h"
+#include "timerwheel.h"
+#include "output.h"
+#include "instrument.h"
+#include "arena.h"
+
+volatile sig_atomic_t periodic_stop_requested = 0;
+
+// Os (até) cpus jobs pendentes com menor chave, por ordem de (chave, índice).
+// Inserção ordenada num vetor de cpus posições: O(n * cpus) por evento.
+static int select_top(const int* key, const int* remaining, const int* arrival,
+                      int time, int n, int cpus, int* selected) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (remaining[i] < 1 || arrival[i] > time) continue;
+        if (count == cpus && key[i] >= key[selected[cpus - 1]]) continue;
+        int j = count < cpus ? count++ : cpus - 1;
+        while (j > 0 && key[selected[j - 1]] > key[i]) {
+            selected[j] = selected[j - 1];
+            j--;
+        }
+        selected[j] = i;
+    }
+    return count;
+}
+
+// Agenda na roda as liberações ainda por acontecer (as passadas, de uma
+// simulação retomada ou de tarefas sem período, já não voltam)
+static void schedule_releases(TimerWheel* releases, const ProcessTable* table, int time) {
+    wheel_reset(releases, time);
+    for (int i = 0; i < table->size; i++)
+        if (table->next_release[i] >= time)
+            wheel_schedule(releases, i, table->next_release[i]);
+}
+
+static int compare_index(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+// ======== HIPERPERÍODO =========
+// Depois de todas as tarefas terem chegado, as liberações repetem-se a cada
+// hiperperíodo H (mmc dos períodos). Nos instantes T0 + k*H o estado da
+// simulação resume-se ao tempo restante de cada tarefa (as próximas
+// liberações relativas ao relógio são sempre as mesmas); se for igual ao de
+// um instante anterior, a simulação a partir daí repete esse ciclo e o resto
+// do horizonte pode ser contado em vez de simulado. Guardam-se os últimos
+// SNAPSHOTS estados para apanhar também ciclos de alguns hiperperíodos.
+#define SNAPSHOTS 4
+
+typedef struct {
+    int* remaining;         // SNAPSHOTS vetores de n
+    long long* misses;      // idem, perdas acumuladas por tarefa
+    Histogram* response;    // SNAPSHOTS cópias dos histogramas (NULL se não se registam)
+    Histogram* lateness;
+    long long cpu_time[SNAPSHOTS];
+    long long time[SNAPSHOTS];
+    int count;
+} Snapshots;
+
+static long long gcd(long long a, long long b) {
+    while (b) {
+        long long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// mmc dos períodos positivos (tarefas sem período só são liberadas uma vez);
+// -1 se exceder limit ou houver períodos negativos
+static long long hyperperiod(const ProcessTable* table, long long limit) {
+    long long h = 1;
+    for (int i = 0; i < table->size; i++) {
+        long long p = table->period[i];
+        if (p < 0) return -1;
+        if (p == 0) continue;
+        h = h / gcd(h, p) * p;
+        if (h > limit) return -1;
+    }
+    return h;
+}
+
+// Índice de um estado guardado igual ao atual, do mais recente para o mais
+// antigo (-1 se nenhum); senão guarda o atual no lugar do mais antigo
+static int snapshot_match(Snapshots* snaps, const ProcessTable* table, const PeriodicSim* sim,
+                          long long time, long long cpu_time) {
+    int n = table->size;
+    for (int k = 1; k <= snaps->count && k <= SNAPSHOTS; k++) {
+        int s = (snaps->count - k) % SNAPSHOTS;
+        if (memcmp(snaps->remaining + (size_t)s * n, table->remaining, sizeof(int) * n) == 0)
+            return s;
+    }
+    int s = snaps->count++ % SNAPSHOTS;
+    memcpy(snaps->remaining + (size_t)s * n, table->remaining, sizeof(int) * n);
+    memcpy(snaps->misses + (size_t)s * n, table->misses, sizeof(long long) * n);
+    if (snaps->response) {
+        hist_copy(&snaps->response[s], sim->response);
+        hist_copy(&snaps->lateness[s], sim->lateness);
+    }
+    snaps->cpu_time[s] = cpu_time;
+    snaps->time[s] = time;
+    return -1;
+}
+// ===============================
+
+// Simulação de tarefas periódicas (RM/EDF) até tempo_total. Entre dois eventos
+// (liberação, conclusão de um job em execução ou fim do horizonte) a escolha
+// não muda, por isso os processos selecionados correm o intervalo inteiro de
+// uma vez. As liberações estão numa roda de temporizadores: cada evento só
+// toca nas tarefas liberadas nesse instante, e como o deadline implícito de
+// um job é a liberação seguinte, é aí também que se deteta a perda.
+// Correm os sim->cpus jobs pendentes de menor período (RM) ou deadline (EDF):
+// a escolha (um argmin_masked com um só processador) é agora a única
+// passagem O(n) por evento, O(n·cpus) com vários. Um job que continua
+// selecionado fica no mesmo processador; os restantes ocupam os livres.
+// A execução é registada como segmentos (timeline.h) e não tick a tick; as
+// perdas de deadline de cada instante ficam no segmento do CPU 0.
+// O relógio é de 32 bits: horizontes maiores só são cobertos por extrapolação.
+// Uma simulação retomada (sim->resume) continua do relógio guardado; o tempo
+// simulado é o relógio mais um desvio que cresce a cada ciclo extrapolado.
+PeriodicResult simulate_periodic(ProcessTable* table, const PeriodicSim* sim) {
+    int n = table->size;
+    int cpus = sim->cpus > 0 ? sim->cpus : 1;
+    int* next_release = table->next_release;
+    int* remaining = table->remaining;
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    const int* key = sim->use_deadline ? next_release : table->period;
+    const PeriodicResume* resume = sim->resume;
+    PeriodicResult result = { resume ? resume->cpu_time : 0, sim->tempo_total, -1, 0, 0, 0, 0, 0 };
+    int current_time = resume ? resume->clock : 0;
+    long long offset = resume ? resume->time - resume->clock : 0;
+    // A linha temporal usa o relógio: só é fiel enquanto não houver desvio
+    Timeline** timelines = offset == 0 ? sim->timelines : NULL;
+
+    // As liberações (next_release) têm de caber no int
+    int max_period = 0, last_arrival = 0;
+    for (int i = 0; i < n; i++) {
+        if (table->period[i] > max_period) max_period = table->period[i];
+        if (table->arrival[i] > last_arrival) last_arrival = table->arrival[i];
+    }
+    long long clock_max = (long long)INT_MAX - max_period;
+    long long limit = sim->tempo_total - offset;
+    int end = (int)(limit < clock_max ? limit : clock_max);
+
+    // Pontos de verificação T0 + k*H, com T0 depois da última chegada (e do
+    // relógio retomado); só compensam se couberem dois hiperperíodos
+    Snapshots snaps = { NULL, NULL, NULL, NULL, { 0 }, { 0 }, 0 };
+    long long hyper = n > 0 ? hyperperiod(table, clock_max / (SNAPSHOTS + 2)) : -1;
+    long long first_checkpoint = last_arrival + 1 > current_time ? last_arrival + 1 : current_time;
+    long long checkpoint = -1;
+    if (hyper > 0 && first_checkpoint + 2 * hyper <= end) {
+        checkpoint = first_checkpoint;
+        snaps.remaining = arena_alloc(arena, sizeof(int) * (size_t)n * SNAPSHOTS);
+        snaps.misses = arena_alloc(arena, sizeof(long long) * (size_t)n * SNAPSHOTS);
+        if (sim->response) {
+            snaps.response = arena_alloc(arena, sizeof(Histogram) * SNAPSHOTS);
+            snaps.lateness = arena_alloc(arena, sizeof(Histogram) * SNAPSHOTS);
+            for (int s = 0; s < SNAPSHOTS; s++) {
+                hist_init(&snaps.response[s]);
+                hist_init(&snaps.lateness[s]);
+            }
+        }
+    }
+
+    int* selected = arena_alloc(arena, sizeof(int) * cpus);
+    int* assigned = arena_alloc(arena, sizeof(int) * cpus);   // job em cada CPU neste intervalo
+    int* running = arena_alloc(arena, sizeof(int) * cpus);    // job do intervalo anterior, se não terminou
+    int* cpu_of = cpus > 1 ? arena_alloc(arena, sizeof(int) * (n > 0 ? n : 1)) : NULL;  // último CPU de cada job
+    int* due = arena_alloc(arena, sizeof(int) * (n > 0 ? n : 1));   // liberados no instante atual
+    TimerWheel* releases = create_timer_wheel(arena, n, current_time);
+    // Só a ordem das linhas MISS depende da ordem dos liberados
+    int sort_due = sim->log_misses && verbosity >= VERBOSITY_JOBS;
+    for (int c = 0; c < cpus; c++)
+        running[c] = -1;
+
+    // Nenhum job está pendente antes da primeira liberação
+    for (int i = 0; i < n; i++) {
+        if (!resume) remaining[i] = 0;
+        if (cpu_of) cpu_of[i] = -1;
+    }
+    schedule_releases(releases, table, current_time);
+
+    INSTR_START(t);
+    while (current_time < end) {
+        int count;
+        int misses = 0;
+
+        if (periodic_stop_requested) {
+            result.interrupted = 1;
+            break;
+        }
+
+        if (current_time == checkpoint) {
+            int s = snapshot_match(&snaps, table, sim, current_time, result.cpu_time);
+            if (s >= 0) {
+                // Regime periódico: conta os ciclos inteiros que faltam e
+                // simula só o resto, que é igual ao início de um ciclo
+                long long cycle = current_time - snaps.time[s];
+                long long left = limit - current_time;
+                result.steady_from = offset + current_time;
+                result.cycle = cycle;
+                result.cycles = left / cycle;
+                result.cpu_time += result.cycles * (result.cpu_time - snaps.cpu_time[s]);
+                for (int i = 0; i < n; i++)
+                    table->misses[i] += result.cycles * (table->misses[i] - snaps.misses[(size_t)s * n + i]);
+                if (snaps.response) {
+                    hist_repeat_since(sim->response, &snaps.response[s], result.cycles);
+                    hist_repeat_since(sim->lateness, &snaps.lateness[s], result.cycles);
+                }
+                // O estado é o mesmo de há um ciclo: recua o relógio para o
+                // resto caber no int
+                current_time -= (int)cycle;
+                offset += (result.cycles + 1) * cycle;
+                for (int i = 0; i < n; i++)
+                    if (table->period[i] > 0) next_release[i] -= (int)cycle;
+                end = current_time + (int)(left % cycle);
+                schedule_releases(releases, table, current_time);
+                timelines = NULL;
+                checkpoint = -1;
+                if (current_time >= end) break;
+            } else {
+                checkpoint += hyper;
+                if (checkpoint + hyper > end) checkpoint = -1;
+            }
+            INSTR_LAP(t, PHASE_ACCOUNT);
+        }
+
+        // Libera os jobs que vencem agora e reagenda a liberação seguinte
+        int fired = wheel_advance(releases, current_time, due);
+        if (sort_due && fired > 1) qsort(due, fired, sizeof(int), compare_index);
+        for (int k = 0; k < fired; k++) {
+            int i = due[k];
+            if (remaining[i] > 0) {
+                table->misses[i]++;
+                misses++;
+                if (sim->log_misses)
+                    LOG_JOB("MISS: Processo %d perdeu o deadline anterior!\n", table->id[i]);
+                if (sim->lateness) hist_record(sim->lateness, remaining[i]);
+            }
+            remaining[i] = table->burst[i];
+            next_release[i] += table->period[i];
+            if (table->period[i] > 0) wheel_schedule(releases, i, next_release[i]);
+        }
+        int next_event = end;
+        if (checkpoint > current_time && checkpoint < next_event)
+            next_event = (int)checkpoint;
+        if (wheel_next(releases) < next_event)
+            next_event = wheel_next(releases);
+        INSTR_LAP(t, PHASE_RELEASE);
+
+        // RM: menor período; EDF: deadline mais próximo (= próxima liberação)
+        result.decisions++;
+        if (cpus == 1) {
+            selected[0] = argmin_masked(key, remaining, 1, table->arrival, current_time, n);
+            count = selected[0] != -1;
+        } else {
+            count = select_top(key, remaining, table->arrival, current_time, n, cpus, selected);
+        }
+        INSTR_COUNT(COUNT_SCANS, 1);
+        INSTR_COUNT(COUNT_SELECT_ITERATIONS, n);
+
+        // Próximo evento: liberação futura, conclusão ou fim do horizonte
+        for (int k = 0; k < count; k++)
+            if (remaining[selected[k]] < next_event - current_time)
+                next_event = current_time + remaining[selected[k]];
+
+        if (cpus == 1) {
+            assigned[0] = count ? selected[0] : -1;
+        } else {
+            for (int c = 0; c < cpus; c++)
+                assigned[c] = -1;
+            for (int k = 0; k < count; k++) {
+                int c = cpu_of[selected[k]];
+                if (c >= 0 && running[c] == selected[k]) assigned[c] = selected[k];
+            }
+            int free_cpu = 0;
+            for (int k = 0; k < count; k++) {
+                int c = cpu_of[selected[k]];
+                if (c >= 0 && assigned[c] == selected[k]) continue;
+                while (assigned[free_cpu] != -1) free_cpu++;
+                assigned[free_cpu] = selected[k];
+                cpu_of[selected[k]] = free_cpu;
+            }
+        }
+        INSTR_LAP(t, PHASE_SELECT);
+
+        for (int c = 0; c < cpus; c++) {
+            int job = assigned[c];
+            if (job != running[c]) {
+                if (job != -1) INSTR_COUNT(COUNT_CONTEXT_SWITCHES, 1);
+                if (running[c] != -1) INSTR_COUNT(COUNT_PREEMPTIONS, 1);
+            }
+            if (job == -1) INSTR_COUNT(COUNT_IDLE_TICKS, next_event - current_time);
+            if (timelines) {
+                if (running[c] != -1 && running[c] != job)
+                    timeline_mark_preempted(timelines[c]);
+                timeline_append(timelines[c], current_time, next_event,
+                                job != -1 ? table->id[job] : -1, c == 0 ? misses : 0);
+                INSTR_LAP(t, PHASE_OUTPUT);
+            }
+            if (job != -1) {
+                remaining[job] -= next_event - current_time;
+                result.cpu_time += next_event - current_time;
+                // Concluído: a liberação foi há um período (o deadline é a
+                // próxima); sem período só há tempo de resposta
+                if (remaining[job] == 0 && sim->response) {
+                    int period = table->period[job];
+                    hist_record(sim->response, next_event - (next_release[job] - period));
+                    if (period > 0) hist_record(sim->lateness, next_event - next_release[job]);
+                }
+            }
+            running[c] = job != -1 && remaining[job] > 0 ? job : -1;
+        }
+        current_time = next_event;
+        INSTR_LAP(t, PHASE_ACCOUNT);
+    }
+
+    result.clock = current_time;
+    result.horizon = offset + current_time;
+
+    arena_release(arena, mark);
+    return result;
+}
+
+void log_periodic_result(const PeriodicResult* result, long long tempo_total) {
+    if (result->steady_from >= 0)
+        LOG("Regime periódico a partir de %lld: ciclo de %lld ticks extrapolado %lld vez(es)\n",
+            result->steady_from, result->cycle, result->cycles);
+    if (result->interrupted)
+        LOG("Simulação interrompida em %lld de %lld ticks\n", result->horizon, tempo_total);
+    else if (result->horizon < tempo_total)
+        LOG("Aviso: sem regime periódico detetado, simulação limitada a %lld de %lld ticks\n",
+            result->horizon, tempo_total);
+}
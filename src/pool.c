@@ -0,0 +1,93 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "pool.h"
+
+// Deque de trabalho de cada worker: o dono tira do fim, os outros roubam do início
+typedef struct {
+    int* jobs;
+    int head;
+    int tail;
+    pthread_mutex_t lock;
+} WorkDeque;
+
+typedef struct {
+    WorkDeque* deques;
+    int num_workers;
+    PoolTask fn;
+    void* ctx;
+} WorkPool;
+
+typedef struct {
+    WorkPool* pool;
+    int id;
+} PoolWorker;
+
+static int deque_pop(WorkDeque* d) {
+    int job = -1;
+    pthread_mutex_lock(&d->lock);
+    if (d->tail > d->head) job = d->jobs[--d->tail];
+    pthread_mutex_unlock(&d->lock);
+    return job;
+}
+
+static int deque_steal(WorkDeque* d) {
+    int job = -1;
+    pthread_mutex_lock(&d->lock);
+    if (d->tail > d->head) job = d->jobs[d->head++];
+    pthread_mutex_unlock(&d->lock);
+    return job;
+}
+
+static void* pool_worker(void* arg) {
+    PoolWorker* worker = arg;
+    WorkPool* pool = worker->pool;
+
+    for (;;) {
+        int task = deque_pop(&pool->deques[worker->id]);
+        for (int k = 1; task < 0 && k < pool->num_workers; k++)
+            task = deque_steal(&pool->deques[(worker->id + k) % pool->num_workers]);
+        if (task < 0) break;  // não são criadas tarefas novas: acabou
+        pool->fn(pool->ctx, task);
+    }
+    return NULL;
+}
+
+// Executa fn(ctx, 0..num_tasks-1) em workers threads com work stealing.
+// Distribuição inicial round-robin; o resto equilibra-se por roubo.
+void pool_run(int workers, int num_tasks, PoolTask fn, void* ctx) {
+    WorkPool pool = { malloc(sizeof(WorkDeque) * workers), workers, fn, ctx };
+    for (int w = 0; w < workers; w++) {
+        pool.deques[w].jobs = malloc(sizeof(int) * (num_tasks / workers + 1));
+        pool.deques[w].head = 0;
+        pool.deques[w].tail = 0;
+        pthread_mutex_init(&pool.deques[w].lock, NULL);
+    }
+    for (int k = 0; k < num_tasks; k++) {
+        WorkDeque* d = &pool.deques[k % workers];
+        d->jobs[d->tail++] = k;
+    }
+
+    pthread_t* threads = malloc(sizeof(pthread_t) * workers);
+    PoolWorker* args = malloc(sizeof(PoolWorker) * workers);
+    for (int w = 0; w < workers; w++) {
+        args[w].pool = &pool;
+        args[w].id = w;
+        pthread_create(&threads[w], NULL, pool_worker, &args[w]);
+    }
+    for (int w = 0; w < workers; w++)
+        pthread_join(threads[w], NULL);
+
+    for (int w = 0; w < workers; w++) {
+        pthread_mutex_destroy(&pool.deques[w].lock);
+        free(pool.deques[w].jobs);
+    }
+    free(pool.deques);
+    free(threads);
+    free(args);
+}
+
+int pool_workers(int requested) {
+    int workers = requested > 0 ? requested : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    return workers < 1 ? 1 : workers;
+}
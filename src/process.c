@@ -1,74 +1,346 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "process.h"
 #include "utils.h"
+#include "output.h"
+#include "trace.h"
 
 ProcessQueue* create_process_queue(int capacity) {
     ProcessQueue* queue = malloc(sizeof(ProcessQueue));
     queue->list = malloc(sizeof(Process) * capacity);
     queue->size = 0;
     queue->capacity = capacity;
+    queue->mapping = NULL;
+    queue->mapping_size = 0;
     return queue;
 }
 
+static void release_list(ProcessQueue* queue) {
+    if (queue->mapping) {
+        munmap(queue->mapping, queue->mapping_size);
+        queue->mapping = NULL;
+        queue->mapping_size = 0;
+    } else {
+        free(queue->list);
+    }
+}
+
 void destroy_process_queue(ProcessQueue* queue) {
-    free(queue->list);
+    release_list(queue);
     free(queue);
 }
 
+// Garante espaço para capacity processos; uma fila mapeada de um ficheiro
+// binário é primeiro copiada para memória própria
+static void reserve_processes(ProcessQueue* queue, int capacity) {
+    if (queue->mapping) {
+        Process* list = malloc(sizeof(Process) * (capacity > queue->size ? capacity : queue->size));
+        memcpy(list, queue->list, sizeof(Process) * queue->size);
+        release_list(queue);
+        queue->list = list;
+        queue->capacity = capacity > queue->size ? capacity : queue->size;
+    } else if (queue->capacity < capacity) {
+        queue->capacity = capacity;
+        queue->list = realloc(queue->list, sizeof(Process) * queue->capacity);
+    }
+}
+
 void add_process(ProcessQueue* queue, Process proc) {
-    if (queue->size < queue->capacity) {
-        queue->list[queue->size++] = proc;
-    } else {
+    if (queue->size == queue->capacity || queue->mapping) {
         // Resize if needed
-        queue->capacity *= 2;
-        queue->list = realloc(queue->list, sizeof(Process) * queue->capacity);
-        queue->list[queue->size++] = proc;
+        reserve_processes(queue, queue->capacity > 0 ? queue->capacity * 2 : 1);
     }
+    queue->list[queue->size++] = proc;
+}
+
+void init_process_generator(ProcessGenerator* gen, uint64_t seed) {
+    rng_seed(&gen->arrival_rng, seed);
+    gen->burst_rng = gen->arrival_rng;
+    rng_jump(&gen->burst_rng);
+    gen->priority_rng = gen->burst_rng;
+    rng_jump(&gen->priority_rng);
+    gen->period_rng = gen->priority_rng;
+    rng_jump(&gen->period_rng);
+    gen->cumulative_arrival = 0;
+    gen->next_id = 1;
 }
 
-Process generate_random_process(int id, int current_time) {
-    static int cumulative_arrival = 0; // mantém tempo de chegada cumulativo
+static Process make_process(ProcessGenerator* gen, double inter_arrival, double burst) {
     Process p;
 
-    int inter_arrival = (int)generate_exponential(1.5); // tempo entre chegadas
-    cumulative_arrival += inter_arrival;
+    gen->cumulative_arrival += (int)inter_arrival; // tempo entre chegadas
 
-    p.id = id;
-    p.arrival_time = cumulative_arrival;
-    p.burst_time = (int)generate_exponential(4.0); // média = 4
+    p.id = gen->next_id++;
+    p.arrival_time = gen->cumulative_arrival;
+    p.burst_time = (int)burst; // média = 4
     if (p.burst_time <= 0) p.burst_time = 1;
 
-    p.priority = rand() % 10;
+    p.priority = rng_below(&gen->priority_rng, 10);
     p.remaining_time = p.burst_time;
 
     // Período entre 5 e 20 unidades de tempo
-    p.period = (rand() % 16) + 5;
+    p.period = rng_below(&gen->period_rng, 16) + 5;
     p.deadline = p.arrival_time + p.period;
 
-    printf("Generated Process %d: chegada=%d, burst=%d, prioridade=%d, periodo=%d, deadline=%d\n", 
+    LOG_JOB("Generated Process %d: chegada=%d, burst=%d, prioridade=%d, periodo=%d, deadline=%d\n", 
            p.id, p.arrival_time, p.burst_time, p.priority, p.period, p.deadline);
 
     return p;
 }
 
-void load_processes_from_file(ProcessQueue *queue) {
-    // Caminho fixo para o arquivo de entrada
-    const char* filename = "data/example_input.txt";
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+Process generate_random_process(ProcessGenerator* gen) {
+    double inter_arrival = rng_exponential(&gen->arrival_rng, 1.5);
+    double burst = rng_exponential(&gen->burst_rng, 4.0);
+    return make_process(gen, inter_arrival, burst);
+}
+
+// Gera n processos para out, com os kernels de variáveis em lote
+static void generate_block(ProcessGenerator* gen, Process* out, int n) {
+    enum { BATCH = 4096 };
+    double inter_arrival[BATCH];
+    double burst[BATCH];
+
+    for (int done = 0; done < n; done += BATCH) {
+        int m = n - done < BATCH ? n - done : BATCH;
+        fill_exponential(&gen->arrival_rng, 1.5, inter_arrival, m);
+        fill_exponential(&gen->burst_rng, 4.0, burst, m);
+        for (int i = 0; i < m; i++)
+            out[done + i] = make_process(gen, inter_arrival[i], burst[i]);
+    }
+}
+
+// Gera count processos em blocos
+void generate_processes(ProcessGenerator* gen, ProcessQueue* queue, int count) {
+    reserve_processes(queue, queue->size + count);
+    generate_block(gen, queue->list + queue->size, count);
+    queue->size += count;
+}
+
+ProcessStream* create_process_stream(uint64_t seed, long long total) {
+    ProcessStream* stream = malloc(sizeof(ProcessStream));
+    init_process_generator(&stream->gen, seed);
+    stream->trace = NULL;
+    stream->remaining = total;
+    stream->total = total;
+    stream->head = 0;
+    stream->count = 0;
+    return stream;
+}
+
+ProcessStream* create_trace_stream(TraceReader* trace, long long limit) {
+    ProcessStream* stream = create_process_stream(0, limit > 0 ? limit : LLONG_MAX);
+    stream->trace = trace;
+    stream->total = -1;
+    return stream;
+}
+
+void destroy_process_stream(ProcessStream* stream) {
+    free(stream);
+}
+
+// Próximo processo a chegar, sem o consumir; gera um novo bloco se preciso
+const Process* stream_peek(ProcessStream* stream) {
+    if (stream->head == stream->count) {
+        if (stream->remaining == 0) return NULL;
+        int n = stream->remaining < PROCESS_STREAM_BLOCK ? (int)stream->remaining : PROCESS_STREAM_BLOCK;
+        if (stream->trace) {
+            n = trace_read(stream->trace, stream->block, n);
+            if (n == 0) {
+                stream->remaining = 0;
+                return NULL;
+            }
+        } else {
+            generate_block(&stream->gen, stream->block, n);
+        }
+        stream->remaining -= n;
+        stream->head = 0;
+        stream->count = n;
+    }
+    return &stream->block[stream->head];
+}
+
+Process stream_pop(ProcessStream* stream) {
+    Process p = *stream_peek(stream);
+    stream->head++;
+    return p;
+}
+
+// ======== FICHEIROS DE CARGA =========
+// Texto: uma linha por processo com
+//   id chegada burst prioridade [período [deadline]]
+// (sem deadline, deadline = chegada + período). Binário: cabeçalho
+// WorkloadHeader seguido de count registos Process, na ordem de bytes da
+// máquina; é mapeado com mmap e usado diretamente como lista da fila.
+
+static const char WORKLOAD_MAGIC[8] = { 'P', 'S', 'C', 'H', 'E', 'D', 'B', '1' };
+
+typedef struct {
+    char magic[8];
+    uint32_t record_size;   // sizeof(Process), para rejeitar formatos antigos
+    uint32_t reserved;
+    uint64_t count;
+} WorkloadHeader;
+
+// Lê um inteiro com sinal a partir de *p, sem passar o fim da linha;
+// devolve 0 se não houver mais nenhum na linha e -1 se não for um número
+// ou não couber num int
+static int parse_int_field(const char** p, const char* end, int* value) {
+    const char* c = *p;
+    while (c < end && (*c == ' ' || *c == '\t' || *c == '\r')) c++;
+    if (c == end || *c == '\n') {
+        *p = c;
+        return 0;
+    }
+
+    int negative = *c == '-';
+    if (*c == '-' || *c == '+') c++;
+    if (c == end || *c < '0' || *c > '9') {
+        *p = c;
+        return -1;
+    }
+    // Para de acumular acima do int (sem overflow) mas consome os dígitos
+    long long v = 0;
+    long long limit = negative ? -(long long)INT_MIN : INT_MAX;
+    while (c < end && *c >= '0' && *c <= '9') {
+        if (v <= limit) v = v * 10 + (*c - '0');
+        c++;
+    }
+    *p = c;
+    if (v > limit) return -1;
+    *value = (int)(negative ? -v : v);
+    return 1;
+}
+
+static int load_text(ProcessQueue* queue, const char* path, const char* data, size_t size) {
+    const char* end = data + size;
+
+    // Preenche a fila de uma vez: conta as linhas antes de reservar
+    int lines = 0;
+    for (const char* c = data; c < end && (c = memchr(c, '\n', end - c)); c++)
+        lines++;
+    reserve_processes(queue, queue->size + lines + 1);
+
+    int loaded = 0, line = 0;
+    const char* p = data;
+    while (p < end) {
+        int fields[6];
+        int n = 0, r;
+        line++;
+        while (n < 6 && (r = parse_int_field(&p, end, &fields[n])) == 1)
+            n++;
+        if (n < 6 && r < 0) n = -1;
+        else if (n == 6 && parse_int_field(&p, end, &r) != 0) n = -1;
+
+        if (n == -1 || (n > 0 && n < 4)) {
+            fprintf(stderr, "Erro: %s:%d: linha inválida\n", path, line);
+            return -1;
+        }
+        if (n > 0) {
+            Process proc;
+            proc.id = fields[0];
+            proc.arrival_time = fields[1];
+            proc.burst_time = fields[2];
+            proc.priority = fields[3];
+            proc.remaining_time = proc.burst_time;
+            proc.period = n >= 5 ? fields[4] : 0;
+            proc.deadline = n >= 6 ? fields[5] : proc.arrival_time + proc.period;
+            queue->list[queue->size++] = proc;
+            loaded++;
+        }
+
+        if (p < end) p++;  // parse_int_field parou no '\n'
+    }
+    return loaded;
+}
+
+// Carrega processos de path (texto ou binário, detetado pelo cabeçalho).
+// Devolve o número de processos lidos, ou -1 em caso de erro.
+int load_processes_from_file(ProcessQueue* queue, const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
         perror("Erro ao abrir ficheiro");
-        return;
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror("Erro ao ler ficheiro");
+        close(fd);
+        return -1;
+    }
+    size_t size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        return 0;
     }
 
-    Process p;
-    // Lê o arquivo e adiciona processos à fila
-    while (fscanf(file, "%d %d %d %d", &p.id, &p.arrival_time, &p.burst_time, &p.priority) == 4) {
-        p.remaining_time = p.burst_time;
-        add_process(queue, p);
+    // MAP_PRIVATE: os escalonadores podem reordenar a lista sem tocar no ficheiro
+    char* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("Erro ao mapear ficheiro");
+        return -1;
+    }
+
+    if (size < sizeof(WorkloadHeader) || memcmp(data, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC)) != 0) {
+        madvise(data, size, MADV_SEQUENTIAL);
+        int loaded = load_text(queue, path, data, size);
+        munmap(data, size);
+        return loaded;
+    }
+
+    const WorkloadHeader* header = (const WorkloadHeader*)data;
+    if (header->record_size != sizeof(Process) || header->count > INT32_MAX ||
+        header->count > (size - sizeof(WorkloadHeader)) / sizeof(Process)) {
+        fprintf(stderr, "Erro: %s: ficheiro binário inválido\n", path);
+        munmap(data, size);
+        return -1;
     }
 
-    fclose(file);
+    int count = (int)header->count;
+    Process* records = (Process*)(data + sizeof(WorkloadHeader));
+    if (queue->size == 0) {
+        // Sem cópia: a lista da fila passa a ser o próprio mapeamento
+        release_list(queue);
+        queue->list = records;
+        queue->size = count;
+        queue->capacity = count;
+        queue->mapping = data;
+        queue->mapping_size = size;
+    } else {
+        reserve_processes(queue, queue->size + count);
+        memcpy(queue->list + queue->size, records, sizeof(Process) * count);
+        queue->size += count;
+        munmap(data, size);
+    }
+    return count;
 }
 
+// Grava a fila no formato binário. Devolve 0, ou -1 em caso de erro.
+int save_processes_binary(const ProcessQueue* queue, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        perror("Erro ao criar ficheiro");
+        return -1;
+    }
 
+    WorkloadHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC));
+    header.record_size = sizeof(Process);
+    header.count = queue->size;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(queue->list, sizeof(Process), queue->size, file) == (size_t)queue->size;
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        perror("Erro ao escrever ficheiro");
+        return -1;
+    }
+    return 0;
+}
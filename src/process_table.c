@@ -0,0 +1,36 @@
+#include "process_table.h"
+
+#define TABLE_ALIGN 64
+#define TABLE_COLUMNS 8   // colunas int
+
+ProcessTable* create_process_table(Arena* arena, const ProcessQueue* queue) {
+    ProcessTable* table = arena_alloc(arena, sizeof(ProcessTable));
+    int n = queue->size;
+
+    // Cada coluna começa numa linha de cache; a de perdas é de 64 bits (a
+    // extrapolação de horizontes longos excede o int) e vem no fim
+    size_t stride = ((size_t)n * sizeof(int) + TABLE_ALIGN - 1) / TABLE_ALIGN * TABLE_ALIGN;
+    if (stride == 0) stride = TABLE_ALIGN;
+    char* block = arena_alloc_aligned(arena, stride * (TABLE_COLUMNS + 2), TABLE_ALIGN);
+    int** columns[TABLE_COLUMNS] = { &table->id, &table->arrival, &table->burst, &table->priority,
+                                     &table->period, &table->deadline, &table->remaining,
+                                     &table->next_release };
+    for (int c = 0; c < TABLE_COLUMNS; c++)
+        *columns[c] = (int*)(block + c * stride);
+    table->misses = (long long*)(block + TABLE_COLUMNS * stride);
+    table->size = n;
+
+    for (int i = 0; i < n; i++) {
+        const Process* p = &queue->list[i];
+        table->id[i] = p->id;
+        table->arrival[i] = p->arrival_time;
+        table->burst[i] = p->burst_time;
+        table->priority[i] = p->priority;
+        table->period[i] = p->period;
+        table->deadline[i] = p->deadline;
+        table->remaining[i] = p->burst_time;
+        table->next_release[i] = p->arrival_time;
+        table->misses[i] = 0;
+    }
+    return table;
+}
@@ -0,0 +1,247 @@
+#include "rbtree.h"
+
+// Algoritmos de Cormen et al. (Introduction to Algorithms, cap. 13), com o
+// nó 0 como a sentinela nil: é preto e o seu pai pode ser escrito durante
+// a remoção.
+#define NIL 0
+
+static void mark_absent(RbTree* tree, int from, int to) {
+    for (int i = from; i < to; i++)
+        tree->nodes[i + 1].parent = -1;
+}
+
+RbTree* create_rb_tree(Arena* arena, int capacity) {
+    RbTree* tree = arena_alloc(arena, sizeof(RbTree));
+    tree->nodes = arena_alloc(arena, sizeof(RbNode) * (capacity + 1));
+    tree->nodes[NIL].left = tree->nodes[NIL].right = tree->nodes[NIL].parent = NIL;
+    tree->nodes[NIL].red = 0;
+    tree->root = NIL;
+    tree->first = NIL;
+    tree->size = 0;
+    tree->capacity = capacity;
+    tree->arena = arena;
+    mark_absent(tree, 0, capacity);
+    return tree;
+}
+
+// Garante espaço para ids até id (a fila de jobs vivos pode crescer)
+static void rb_grow(RbTree* tree, int id) {
+    int capacity = tree->capacity > 0 ? tree->capacity : 1;
+    while (capacity <= id) capacity *= 2;
+    tree->nodes = arena_grow(tree->arena, tree->nodes, sizeof(RbNode) * (tree->capacity + 1),
+                             sizeof(RbNode) * (capacity + 1));
+    mark_absent(tree, tree->capacity, capacity);
+    tree->capacity = capacity;
+}
+
+static int node_less(const RbNode* a, const RbNode* b) {
+    return a->key < b->key || (a->key == b->key && a->tie < b->tie);
+}
+
+static void rotate_left(RbTree* tree, int x) {
+    RbNode* n = tree->nodes;
+    int y = n[x].right;
+    n[x].right = n[y].left;
+    if (n[y].left != NIL) n[n[y].left].parent = x;
+    n[y].parent = n[x].parent;
+    if (n[x].parent == NIL) tree->root = y;
+    else if (x == n[n[x].parent].left) n[n[x].parent].left = y;
+    else n[n[x].parent].right = y;
+    n[y].left = x;
+    n[x].parent = y;
+}
+
+static void rotate_right(RbTree* tree, int x) {
+    RbNode* n = tree->nodes;
+    int y = n[x].left;
+    n[x].left = n[y].right;
+    if (n[y].right != NIL) n[n[y].right].parent = x;
+    n[y].parent = n[x].parent;
+    if (n[x].parent == NIL) tree->root = y;
+    else if (x == n[n[x].parent].right) n[n[x].parent].right = y;
+    else n[n[x].parent].left = y;
+    n[y].right = x;
+    n[x].parent = y;
+}
+
+void rb_insert(RbTree* tree, int id, long long key, long long tie) {
+    if (id >= tree->capacity) rb_grow(tree, id);
+    RbNode* n = tree->nodes;
+    int z = id + 1;
+    n[z].key = key;
+    n[z].tie = tie;
+
+    int y = NIL;
+    int x = tree->root;
+    while (x != NIL) {
+        y = x;
+        x = node_less(&n[z], &n[x]) ? n[x].left : n[x].right;
+    }
+    n[z].parent = y;
+    if (y == NIL) tree->root = z;
+    else if (node_less(&n[z], &n[y])) n[y].left = z;
+    else n[y].right = z;
+    n[z].left = n[z].right = NIL;
+    n[z].red = 1;
+    if (tree->first == NIL || node_less(&n[z], &n[tree->first])) tree->first = z;
+    tree->size++;
+
+    while (n[n[z].parent].red) {
+        int p = n[z].parent;
+        int g = n[p].parent;
+        if (p == n[g].left) {
+            int u = n[g].right;
+            if (n[u].red) {
+                n[p].red = n[u].red = 0;
+                n[g].red = 1;
+                z = g;
+            } else {
+                if (z == n[p].right) {
+                    z = p;
+                    rotate_left(tree, z);
+                    p = n[z].parent;
+                }
+                n[p].red = 0;
+                n[g].red = 1;
+                rotate_right(tree, g);
+            }
+        } else {
+            int u = n[g].left;
+            if (n[u].red) {
+                n[p].red = n[u].red = 0;
+                n[g].red = 1;
+                z = g;
+            } else {
+                if (z == n[p].left) {
+                    z = p;
+                    rotate_right(tree, z);
+                    p = n[z].parent;
+                }
+                n[p].red = 0;
+                n[g].red = 1;
+                rotate_left(tree, g);
+            }
+        }
+    }
+    n[tree->root].red = 0;
+}
+
+static int subtree_min(const RbNode* n, int x) {
+    while (n[x].left != NIL) x = n[x].left;
+    return x;
+}
+
+static void transplant(RbTree* tree, int u, int v) {
+    RbNode* n = tree->nodes;
+    if (n[u].parent == NIL) tree->root = v;
+    else if (u == n[n[u].parent].left) n[n[u].parent].left = v;
+    else n[n[u].parent].right = v;
+    n[v].parent = n[u].parent;
+}
+
+static void remove_fixup(RbTree* tree, int x) {
+    RbNode* n = tree->nodes;
+    while (x != tree->root && !n[x].red) {
+        int p = n[x].parent;
+        if (x == n[p].left) {
+            int w = n[p].right;
+            if (n[w].red) {
+                n[w].red = 0;
+                n[p].red = 1;
+                rotate_left(tree, p);
+                w = n[p].right;
+            }
+            if (!n[n[w].left].red && !n[n[w].right].red) {
+                n[w].red = 1;
+                x = p;
+            } else {
+                if (!n[n[w].right].red) {
+                    n[n[w].left].red = 0;
+                    n[w].red = 1;
+                    rotate_right(tree, w);
+                    w = n[p].right;
+                }
+                n[w].red = n[p].red;
+                n[p].red = 0;
+                n[n[w].right].red = 0;
+                rotate_left(tree, p);
+                x = tree->root;
+            }
+        } else {
+            int w = n[p].left;
+            if (n[w].red) {
+                n[w].red = 0;
+                n[p].red = 1;
+                rotate_right(tree, p);
+                w = n[p].left;
+            }
+            if (!n[n[w].right].red && !n[n[w].left].red) {
+                n[w].red = 1;
+                x = p;
+            } else {
+                if (!n[n[w].left].red) {
+                    n[n[w].right].red = 0;
+                    n[w].red = 1;
+                    rotate_left(tree, w);
+                    w = n[p].left;
+                }
+                n[w].red = n[p].red;
+                n[p].red = 0;
+                n[n[w].left].red = 0;
+                rotate_right(tree, p);
+                x = tree->root;
+            }
+        }
+    }
+    n[x].red = 0;
+}
+
+void rb_remove(RbTree* tree, int id) {
+    if (!rb_contains(tree, id)) return;
+    RbNode* n = tree->nodes;
+    int z = id + 1;
+
+    // O primeiro não tem filho esquerdo: o seguinte é o mínimo da subárvore
+    // direita ou, sem ela, o pai
+    if (z == tree->first)
+        tree->first = n[z].right != NIL ? subtree_min(n, n[z].right) : n[z].parent;
+
+    int y = z;
+    int y_red = n[y].red;
+    int x;
+    if (n[z].left == NIL) {
+        x = n[z].right;
+        transplant(tree, z, n[z].right);
+    } else if (n[z].right == NIL) {
+        x = n[z].left;
+        transplant(tree, z, n[z].left);
+    } else {
+        y = subtree_min(n, n[z].right);
+        y_red = n[y].red;
+        x = n[y].right;
+        if (n[y].parent == z) {
+            n[x].parent = y;
+        } else {
+            transplant(tree, y, n[y].right);
+            n[y].right = n[z].right;
+            n[n[y].right].parent = y;
+        }
+        transplant(tree, z, y);
+        n[y].left = n[z].left;
+        n[n[y].left].parent = y;
+        n[y].red = n[z].red;
+    }
+    if (!y_red) remove_fixup(tree, x);
+
+    n[NIL].parent = NIL;
+    n[z].parent = -1;
+    tree->size--;
+}
+
+int rb_last(const RbTree* tree) {
+    const RbNode* n = tree->nodes;
+    int x = tree->root;
+    if (x == NIL) return -1;
+    while (n[x].right != NIL) x = n[x].right;
+    return x - 1;
+}
@@ -0,0 +1,29 @@
+#include <stdlib.h>
+#include "ring.h"
+
+RingQueue* create_ring_queue(Arena* arena, int capacity) {
+    int cap = 1;
+    while (cap < capacity) cap *= 2;
+
+    RingQueue* ring = arena_alloc(arena, sizeof(RingQueue));
+    ring->items = arena_alloc(arena, sizeof(int) * cap);
+    ring->head = 0;
+    ring->size = 0;
+    ring->capacity = cap;
+    ring->arena = arena;
+    return ring;
+}
+
+void ring_push(RingQueue* ring, int id) {
+    if (ring->size == ring->capacity) {
+        // Duplica e desenrola o conteúdo para o início do novo buffer
+        int* items = arena_alloc(ring->arena, sizeof(int) * ring->capacity * 2);
+        for (int i = 0; i < ring->size; i++)
+            items[i] = ring->items[(ring->head + i) & (ring->capacity - 1)];
+        ring->items = items;
+        ring->head = 0;
+        ring->capacity *= 2;
+    }
+    ring->items[(ring->head + ring->size) & (ring->capacity - 1)] = id;
+    ring->size++;
+}
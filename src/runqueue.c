@@ -0,0 +1,58 @@
+#include <stdlib.h>
+#include "runqueue.h"
+
+RunQueue* create_run_queue(Arena* arena, int capacity) {
+    RunQueue* rq = arena_alloc(arena, sizeof(RunQueue));
+    int cap = capacity > 0 ? capacity : 1;
+    rq->bitmap = 0;
+    for (int l = 0; l < RQ_LEVELS; l++)
+        rq->head[l] = rq->tail[l] = -1;
+    rq->next = arena_alloc(arena, sizeof(int) * cap);
+    rq->prev = arena_alloc(arena, sizeof(int) * cap);
+    rq->level = arena_alloc(arena, sizeof(int) * cap);
+    for (int i = 0; i < cap; i++)
+        rq->level[i] = -1;
+    rq->size = 0;
+    rq->capacity = cap;
+    rq->arena = arena;
+    return rq;
+}
+
+// Garante espaço para ids até id (a fila de jobs vivos pode crescer)
+static void rq_grow(RunQueue* rq, int id) {
+    int capacity = rq->capacity;
+    while (capacity <= id) capacity *= 2;
+    rq->next = arena_grow(rq->arena, rq->next, sizeof(int) * rq->capacity, sizeof(int) * capacity);
+    rq->prev = arena_grow(rq->arena, rq->prev, sizeof(int) * rq->capacity, sizeof(int) * capacity);
+    rq->level = arena_grow(rq->arena, rq->level, sizeof(int) * rq->capacity, sizeof(int) * capacity);
+    for (int i = rq->capacity; i < capacity; i++)
+        rq->level[i] = -1;
+    rq->capacity = capacity;
+}
+
+// Insere id no fim da FIFO do nível (0 <= level < RQ_LEVELS)
+void rq_push(RunQueue* rq, int id, int level) {
+    if (id >= rq->capacity) rq_grow(rq, id);
+    int tail = rq->tail[level];
+    rq->level[id] = level;
+    rq->next[id] = -1;
+    rq->prev[id] = tail;
+    if (tail >= 0) rq->next[tail] = id;
+    else rq->head[level] = id;
+    rq->tail[level] = id;
+    rq->bitmap |= 1ULL << level;
+    rq->size++;
+}
+
+void rq_remove(RunQueue* rq, int id) {
+    if (!rq_contains(rq, id)) return;
+    int level = rq->level[id];
+    int prev = rq->prev[id], next = rq->next[id];
+    if (prev >= 0) rq->next[prev] = next;
+    else rq->head[level] = next;
+    if (next >= 0) rq->prev[next] = prev;
+    else rq->tail[level] = prev;
+    if (rq->head[level] < 0) rq->bitmap &= ~(1ULL << level);
+    rq->level[id] = -1;
+    rq->size--;
+}
@@ -2,6 +2,18 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "scheduler.h"
+#include "heap.h"
+#include "runqueue.h"
+#include "ring.h"
+#include "rbtree.h"
+#include "mlfq.h"
+#include "utils.h"
+#include "output.h"
+#include "timeline.h"
+#include "process_table.h"
+#include "periodic.h"
+#include "instrument.h"
+#include "arena.h"
 #include <limits.h>
 
 
@@ -22,762 +34,1098 @@ int compare_by_deadline(const void* a, const void* b) {
     return ((Process*)a)->deadline - ((Process*)b)->deadline;
 }
 
-// FCFS correto (já existia)
-void run_fcfs(ProcessQueue* queue) {
-    qsort(queue->list, queue->size, sizeof(Process), compare_by_arrival);
+// ======== NÚCLEO ORIENTADO A EVENTOS =========
+// Em vez de avançar o relógio uma unidade de cada vez, os escalonadores saltam
+// diretamente para o próximo instante em que algo pode mudar: uma chegada, uma
+// liberação periódica, uma conclusão, uma preempção ou o fim do horizonte.
+
+#define AGING_THRESHOLD 10  // espera (em ticks) a partir da qual o aging atua
+
+// Chaves dos heaps com desempate embutido: valor * 2^32 + sequência, onde a
+// sequência é o índice original do processo (único), para que empates sejam
+// resolvidos pelo menor índice tal como nas pesquisas lineares
+#define SEQ_SPAN (1LL << 32)
+#define TIE_KEY(value, seq) ((long long)(value) * SEQ_SPAN + (seq))
+#define KEY_SEQ(key) ((key) & (SEQ_SPAN - 1))
+
+typedef struct {
+    int arrival;
+    int idx;
+} ArrivalEntry;
+
+static int compare_arrival_entry(const void* a, const void* b) {
+    const ArrivalEntry* x = a;
+    const ArrivalEntry* y = b;
+    if (x->arrival != y->arrival) return x->arrival < y->arrival ? -1 : 1;
+    return x->idx - y->idx;
+}
 
-    int current_time = 0;
-    int total_wait = 0, total_turnaround = 0, total_burst = 0;  // Adicionar total_burst
+// Índices dos processos por ordem de chegada (empates pelo índice original).
+static int* arrival_order(Arena* arena, const ProcessTable* table) {
+    int* order = arena_alloc(arena, sizeof(int) * (table->size > 0 ? table->size : 1));
+    ArrivalEntry* entries = arena_alloc(arena, sizeof(ArrivalEntry) * (table->size > 0 ? table->size : 1));
+    for (int i = 0; i < table->size; i++) {
+        entries[i].arrival = table->arrival[i];
+        entries[i].idx = i;
+    }
+    qsort(entries, table->size, sizeof(ArrivalEntry), compare_arrival_entry);
+    for (int i = 0; i < table->size; i++)
+        order[i] = entries[i].idx;
+    return order;
+}
 
-    printf("\n[FCFS] Escalonamento:\n");
-    for (int i = 0; i < queue->size; i++) {
-        Process p = queue->list[i];
-        if (current_time < p.arrival_time)
-            current_time = p.arrival_time;
+// ======== FONTE DE CHEGADAS =========
+// Os escalonadores de jobs consomem os processos por ordem de chegada a partir
+// de uma fonte: uma ProcessTable já materializada (percorrida por um cursor
+// sobre arrival_order) ou uma ProcessStream, gerada à medida que o relógio
+// avança. Cada processo entregue traz a sua sequência de desempate. As
+// estruturas da execução saem da arena da fonte.
+typedef struct {
+    Arena* arena;
+    ProcessTable* table;
+    int* order;
+    int next;
+    ProcessStream* stream;
+    long long arrived;      // processos já entregues
+} ArrivalSource;
+
+static void source_from_queue(ArrivalSource* src, Arena* arena, ProcessQueue* queue) {
+    src->arena = arena;
+    src->table = create_process_table(arena, queue);
+    src->order = arrival_order(arena, src->table);
+    src->next = 0;
+    src->stream = NULL;
+    src->arrived = 0;
+}
 
-        int wait_time = current_time - p.arrival_time;
-        int turnaround = wait_time + p.burst_time;
-        current_time += p.burst_time;
-        total_burst += p.burst_time;  // Soma o tempo de execução do processo
+static void source_from_stream(ArrivalSource* src, Arena* arena, ProcessStream* stream) {
+    src->arena = arena;
+    src->table = NULL;
+    src->order = NULL;
+    src->next = 0;
+    src->stream = stream;
+    src->arrived = 0;
+}
 
-        printf("Processo %d: chegada = %d, Espera = %d, Turnaround = %d\n",
-               p.id, p.arrival_time, wait_time, turnaround);
+#define NO_ARRIVAL LLONG_MAX
 
-        total_wait += wait_time;
-        total_turnaround += turnaround;
+// Instante da próxima chegada (NO_ARRIVAL se já não há mais); na tabela lê
+// só a coluna arrival
+static long long source_next_arrival(ArrivalSource* src) {
+    if (src->stream) {
+        const Process* p = stream_peek(src->stream);
+        return p ? p->arrival_time : NO_ARRIVAL;
     }
+    if (src->next == src->table->size) return NO_ARRIVAL;
+    return src->table->arrival[src->order[src->next]];
+}
 
-    float avg_wait = (float)total_wait / queue->size;
-    float avg_turnaround = (float)total_turnaround / queue->size;
-    float throughput = (float)queue->size / current_time;
-    float cpu_utilization = (float)total_burst / current_time * 100; 
+static Process source_pop(ArrivalSource* src, long long* seq) {
+    Process p;
+    if (src->stream) {
+        *seq = src->arrived;
+        p = stream_pop(src->stream);
+    } else {
+        *seq = src->order[src->next];
+        p = table_process(src->table, src->order[src->next++]);
+    }
+    src->arrived++;
+    return p;
+}
 
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f processos/unidade de tempo\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
+// Capacidade inicial das estruturas: o tamanho da tabela, ou um valor pequeno
+// em streaming (crescem com o número de jobs vivos)
+static int source_capacity(const ArrivalSource* src) {
+    return src->stream ? 1024 : src->table->size;
 }
 
+// ======== TABELA DE JOBS VIVOS =========
+// Os jobs que já chegaram e ainda não terminaram ocupam um slot; ao terminar,
+// o slot é libertado e reutilizado pela próxima chegada. A memória fica assim
+// limitada ao número de jobs vivos em simultâneo e não ao total de processos.
+typedef struct {
+    Process* jobs;          // remaining_time é o tempo ainda por executar
+    long long* seq;
+    int* free_slots;
+    int num_free;
+    int used;               // slots já atribuídos alguma vez
+    int capacity;
+    Arena* arena;
+} JobTable;
+
+static void job_table_init(JobTable* t, Arena* arena, int capacity) {
+    t->capacity = capacity > 0 ? capacity : 1;
+    t->jobs = arena_alloc(arena, sizeof(Process) * t->capacity);
+    t->seq = arena_alloc(arena, sizeof(long long) * t->capacity);
+    t->free_slots = arena_alloc(arena, sizeof(int) * t->capacity);
+    t->num_free = 0;
+    t->used = 0;
+    t->arena = arena;
+}
 
-// SJF real
-void run_sjf(ProcessQueue* queue) {
-    int current_time = 0, completed = 0;
-    int wait_time = 0, turnaround = 0, total_burst = 0;
-    int* done = calloc(queue->size, sizeof(int));
+static int job_admit(JobTable* t, Process p, long long seq) {
+    int slot;
+    if (t->num_free > 0) {
+        slot = t->free_slots[--t->num_free];
+    } else {
+        if (t->used == t->capacity) {
+            size_t old = t->capacity;
+            t->capacity *= 2;
+            t->jobs = arena_grow(t->arena, t->jobs, sizeof(Process) * old, sizeof(Process) * t->capacity);
+            t->seq = arena_grow(t->arena, t->seq, sizeof(long long) * old, sizeof(long long) * t->capacity);
+            t->free_slots = arena_grow(t->arena, t->free_slots, sizeof(int) * old, sizeof(int) * t->capacity);
+        }
+        slot = t->used++;
+    }
+    p.remaining_time = p.burst_time;
+    t->jobs[slot] = p;
+    t->seq[slot] = seq;
+    return slot;
+}
 
-    printf("\n[SJF] Escalonamento:\n");
+static void job_retire(JobTable* t, int slot) {
+    t->free_slots[t->num_free++] = slot;
+}
 
-    while (completed < queue->size) {
-        int idx = -1;
-        int min_burst = __INT_MAX__;
-        for (int i = 0; i < queue->size; i++) {
-            Process* p = &queue->list[i];
-            if (!done[i] && p->arrival_time <= current_time && p->burst_time < min_burst) {
-                min_burst = p->burst_time;
-                idx = i;
-            }
-        }
+// ======== AGING PREGUIÇOSO =========
+// O aging original decrementa p->priority de todos os processos à espera há
+// mais de AGING_THRESHOLD em cada passo (cada tick no modo preemptivo, cada
+// decisão no não-preemptivo). Como todos os processos em aging perdem um
+// nível por passo, a ordem entre eles não muda; basta guardar para cada um
+// K = prioridade + passo_inicial - 1, e a prioridade efetiva é K - passo.
+// Cada processo pronto está numa de três filas:
+//  - young:   ainda sem aging, nível = prioridade original
+//  - aging:   nível K % RQ_LEVELS (o primeiro nível a partir de passo + 1 é
+//             o melhor e também o primeiro a chegar a 0)
+//  - clamped: prioridade já em 0, desempata apenas pela ordem de chegada
+// e os que ainda não envelheceram estão também em waiting, por chegada.
+// young, aging e waiting são filas multinível (runqueue.h): as chegadas
+// entram por ordem, pelo que cada FIFO já está ordenada pelo desempate.
+// Os K vivos estão sempre em [passo, passo + RQ_LEVELS), por isso os níveis
+// do aging podem ser circulares. Em clamped juntam-se processos vindos de
+// níveis diferentes e a ordem de chegada só se mantém com um heap; só lá
+// chegam os processos que esperaram mais do que a sua prioridade.
+typedef struct {
+    RunQueue* young;
+    RunQueue* aging;
+    ReadyHeap* clamped;
+    RunQueue* waiting;
+} AgingQueues;
+
+static void aging_init(AgingQueues* q, Arena* arena, int capacity) {
+    q->young = create_run_queue(arena, capacity);
+    q->aging = create_run_queue(arena, capacity);
+    q->clamped = create_ready_heap(arena, capacity);
+    q->waiting = create_run_queue(arena, capacity);
+}
 
-        if (idx == -1) {
-            current_time++;
-            continue;
-        }
+static int aging_empty(const AgingQueues* q) {
+    return q->young->size + q->aging->size + q->clamped->size == 0;
+}
 
-        Process* p = &queue->list[idx];
-        int wait = current_time - p->arrival_time;
-        int turn = wait + p->burst_time;
-        current_time += p->burst_time;
-
-        printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-        wait_time += wait;
-        turnaround += turn;
-        total_burst += p->burst_time;
-        done[idx] = 1;
-        completed++;
-    }
+// Prioridades fora de [0, RQ_LEVELS) são limitadas à entrada, como o
+// MAX_PRIO do Linux; o gerador só produz valores em [0, 10)
+static void aging_admit(AgingQueues* q, JobTable* jobs, int i) {
+    Process* p = &jobs->jobs[i];
+    if (p->priority < 0) p->priority = 0;
+    if (p->priority >= RQ_LEVELS) p->priority = RQ_LEVELS - 1;
+    rq_push(q->young, i, p->priority);
+    rq_push(q->waiting, i, 0);
+}
 
-    float avg_wait = (float)wait_time / queue->size;
-    float avg_turnaround = (float)turnaround / queue->size;
-    float throughput = (float)queue->size / current_time;
-    float cpu_utilization = (float)total_burst / current_time * 100;
-
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f processos/unidade de tempo\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
-    free(done);
-}
-
-// Priority real (com/sem preempção)
-void run_priority(ProcessQueue* queue, int preemptive) {
-    int current_time = 0, completed = 0;
-    int wait_time = 0, turnaround = 0, total_burst = 0;
-    int* remaining = malloc(sizeof(int) * queue->size);
-    int* done = calloc(queue->size, sizeof(int));
-
-    for (int i = 0; i < queue->size; i++)
-        remaining[i] = queue->list[i].burst_time;
-
-    printf("\n[PRIORITY %s] Escalonamento:\n", preemptive ? "Preemptivo" : "Não-Preemptivo");
-
-    while (completed < queue->size) {
-        // ======== AGING =========
-        for (int i = 0; i < queue->size; i++) {
-            Process* p = &queue->list[i];
-            if (!done[i] && p->arrival_time <= current_time && remaining[i] > 0) {
-                int waiting_time = current_time - p->arrival_time;
-                if (waiting_time > 10) { // ajustável
-                    p->priority--; // aumenta prioridade
-                    if (p->priority < 0) p->priority = 0;
-                }
-            }
-        }
-        // ========================
-
-        int idx = -1;
-        int best_prio = __INT_MAX__;
-        for (int i = 0; i < queue->size; i++) {
-            Process* p = &queue->list[i];
-            if (!done[i] && p->arrival_time <= current_time && p->priority < best_prio && remaining[i] > 0) {
-                best_prio = p->priority;
-                idx = i;
-            }
-        }
+// Menor K em aging (só válido com q->aging não vazia)
+static long long aging_top_k(const AgingQueues* q, long long step) {
+    int level = rq_first_level(q->aging, (int)((step + 1) & (RQ_LEVELS - 1)));
+    return step + 1 + ((level - (step + 1)) & (RQ_LEVELS - 1));
+}
 
-        if (idx == -1) {
-            current_time++;
-            continue;
-        }
+// O processo i começa a envelhecer no passo start (primeiro decremento)
+static void aging_start(AgingQueues* q, const JobTable* jobs, int i, long long start, long long step) {
+    long long k = (long long)jobs->jobs[i].priority + start - 1;
+    rq_remove(q->young, i);
+    rq_remove(q->waiting, i);
+    if (k <= step) heap_push(q->clamped, i, jobs->seq[i]);
+    else rq_push(q->aging, i, (int)(k & (RQ_LEVELS - 1)));
+}
 
-        Process* p = &queue->list[idx];
-
-        if (preemptive) {
-            current_time++;
-            remaining[idx]--;
-            total_burst++;
-            if (remaining[idx] == 0) {
-                int wait = current_time - p->arrival_time - p->burst_time;
-                int turn = current_time - p->arrival_time;
-                printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-                wait_time += wait;
-                turnaround += turn;
-                done[idx] = 1;
-                completed++;
-            }
-        } else {
-            int wait = current_time - p->arrival_time;
-            current_time += p->burst_time;
-            int turn = current_time - p->arrival_time;
-            printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-            wait_time += wait;
-            turnaround += turn;
-            total_burst += p->burst_time;
-            done[idx] = 1;
-            completed++;
+// Move para clamped os processos cuja prioridade efetiva chegou a 0. O passo
+// nunca ultrapassa o menor K, por isso só o nível K = passo pode ter chegado.
+static void aging_clamp(AgingQueues* q, const JobTable* jobs, long long step) {
+    int level = (int)(step & (RQ_LEVELS - 1));
+    int i;
+    while ((i = rq_head(q->aging, level)) >= 0) {
+        rq_remove(q->aging, i);
+        heap_push(q->clamped, i, jobs->seq[i]);
+    }
+}
+
+static void aging_remove(AgingQueues* q, int i) {
+    rq_remove(q->young, i);
+    rq_remove(q->aging, i);
+    heap_remove(q->clamped, i);
+    rq_remove(q->waiting, i);
+}
+
+// Melhor processo pronto no passo atual (-1 se nenhum): a cabeça de cada fila
+// já é a melhor dela, basta comparar as três por (prioridade, chegada)
+static int aging_select(const AgingQueues* q, const JobTable* jobs, long long step) {
+    int best = -1;
+    long long best_key = 0;
+    if (q->young->size) {
+        int level = rq_first_level(q->young, 0);
+        best = rq_head(q->young, level);
+        best_key = TIE_KEY(level, jobs->seq[best]);
+    }
+    if (q->aging->size) {
+        long long k = aging_top_k(q, step);
+        int id = rq_head(q->aging, (int)(k & (RQ_LEVELS - 1)));
+        long long key = TIE_KEY(k - step, jobs->seq[id]);
+        if (best < 0 || key < best_key) {
+            best = id;
+            best_key = key;
         }
     }
+    if (q->clamped->size) {
+        long long key = TIE_KEY(0, heap_top_key(q->clamped));
+        if (best < 0 || key < best_key)
+            best = heap_peek(q->clamped);
+    }
+    return best;
+}
+// ===================================
+
+// Distribuições por job de uma simulação RM/EDF (PeriodicSim)
+typedef struct {
+    Histogram response;
+    Histogram lateness;
+} PeriodicLatency;
+
+static PeriodicLatency* create_periodic_latency(Arena* arena) {
+    PeriodicLatency* latency = arena_alloc(arena, sizeof(PeriodicLatency));
+    hist_init(&latency->response);
+    hist_init(&latency->lateness);
+    return latency;
+}
 
-    float avg_wait = (float)wait_time / queue->size;
-    float avg_turnaround = (float)turnaround / queue->size;
-    float throughput = (float)queue->size / current_time;
-    float cpu_utilization = (float)total_burst / current_time * 100;
+// Percentis de resposta e atraso para as estatísticas e a saída
+static void log_periodic_latency(SchedulerStats* stats, const PeriodicLatency* latency) {
+    stats->response_tail = hist_percentiles(&latency->response);
+    stats->lateness_tail = hist_percentiles(&latency->lateness);
+    log_percentiles("Resposta", &stats->response_tail);
+    log_percentiles("Atraso", &stats->lateness_tail);
+}
 
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f processos/unidade de tempo\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
+// RM/EDF num único processador, com a linha temporal na saída se a
+// verbosidade o pedir
+static PeriodicResult simulate_uniprocessor(ProcessTable* table, long long tempo_total, int use_deadline,
+                                            const PeriodicResume* resume, PeriodicLatency* latency) {
+    Timeline* timeline = verbosity >= VERBOSITY_TIMELINE ? create_timeline(64) : NULL;
+    PeriodicSim sim = { tempo_total, use_deadline, 1, timeline ? &timeline : NULL, 1, resume,
+                        &latency->response, &latency->lateness };
+    PeriodicResult result = simulate_periodic(table, &sim);
+
+    if (timeline) {
+        print_timeline(timeline);
+        destroy_timeline(timeline);
+    }
+    log_periodic_result(&result, tempo_total);
+    return result;
+}
 
-    free(remaining);
-    free(done);
+static long long table_misses(const ProcessTable* table) {
+    long long total = 0;
+    for (int i = 0; i < table->size; i++)
+        total += table->misses[i];
+    return total;
+}
+// ============================================
+
+// ======== MOTOR DOS ESCALONADORES DE JOBS =========
+// FCFS, SJF, Priority, Round Robin, CFS e MLFQ, com ou sem horizonte, são o mesmo ciclo
+// de eventos; a política (o algoritmo) escolhe a fila de prontos, a chave de
+// seleção e se há preempção, e o horizonte opcional corta a simulação.
+// job_engine é sempre expandida com estes parâmetros constantes, por isso
+// cada combinação é compilada à parte e o ciclo não testa a política.
+#define NO_HORIZON LLONG_MAX
+
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
+// Fila de prontos de cada política: FIFO (FCFS, RR), heap por burst (SJF),
+// filas de aging (Priority), árvore por vruntime (CFS) ou FIFOs por nível (MLFQ)
+typedef struct {
+    RingQueue* fifo;            // no CFS, as chegadas do instante ainda fora da árvore
+    ReadyHeap* shortest;
+    AgingQueues ranked;
+    RbTree* fair;
+    long long min_vruntime;     // CFS: nunca recua; as chegadas entram com ele
+    long long fair_weight;      // CFS: soma dos pesos dos prontos e do que corre
+    MlfqQueues* feedback;
+    int quanta[MLFQ_MAX_LEVELS];    // MLFQ: quantum de cada nível
+} JobReady;
+
+// ======== CFS =========
+// Como o Completely Fair Scheduler do Linux: cada job acumula vruntime, o
+// tempo de CPU dividido pelo seu peso, e corre sempre o de menor vruntime.
+// O peso vem da prioridade, tratada como nice (0 = peso 1024; cada nível a
+// mais vale ~1,25x menos) com a tabela do kernel. O vruntime está em
+// unidades de 1/VRUNTIME_UNIT tick de um job de peso 1024.
+CfsTunables cfs_tunables = { 6, 1 };
+
+#define CFS_NICE_0_WEIGHT 1024
+#define VRUNTIME_UNIT 1024
+
+static const int cfs_prio_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+    9548, 7620, 6100, 4904, 3906, 3121, 2501, 1991, 1586, 1277,
+    1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+    110, 87, 70, 56, 45, 36, 29, 23, 18, 15
+};
+
+static ALWAYS_INLINE int cfs_weight(int priority) {
+    int nice = priority < -20 ? -20 : priority > 19 ? 19 : priority;
+    return cfs_prio_to_weight[nice + 20];
 }
 
+// Fatia de um job com running jobs prontos: o período, a latência alvo ou
+// min_granularity por job se forem muitos, repartido pelo peso; nunca menos
+// de min_granularity
+static ALWAYS_INLINE long long cfs_slice_of(const JobReady* ready, long long running, int weight) {
+    long long period = cfs_tunables.target_latency;
+    if (running * cfs_tunables.min_granularity > period)
+        period = running * cfs_tunables.min_granularity;
+    long long slice = period * weight / ready->fair_weight;
+    return slice > cfs_tunables.min_granularity ? slice : cfs_tunables.min_granularity;
+}
 
+// Fatia do job fora da árvore (o que vai correr)
+static ALWAYS_INLINE long long cfs_slice(const JobReady* ready, int weight) {
+    return cfs_slice_of(ready, ready->fair->size + 1, weight);
+}
 
+// Coloca na árvore as chegadas do instante, uma fatia depois do
+// min_vruntime (START_DEBIT do Linux): sem crédito pelo tempo em que não
+// existiam e sem passar à frente de quem já espera. A fatia é calculada com
+// o lote inteiro já contado, para que não dependa da ordem de admissão e
+// jobs do mesmo peso que chegam juntos corram por ordem de chegada.
+static ALWAYS_INLINE void cfs_place_arrivals(JobReady* ready, const JobTable* jobs) {
+    long long running = ready->fair->size + ready->fifo->size;
+    int idx;
+    while ((idx = ring_pop(ready->fifo)) >= 0) {
+        int weight = cfs_weight(jobs->jobs[idx].priority);
+        long long debit = cfs_slice_of(ready, running, weight) * CFS_NICE_0_WEIGHT * VRUNTIME_UNIT / weight;
+        rb_insert(ready->fair, idx, ready->min_vruntime + debit, jobs->seq[idx]);
+    }
+}
 
+// min_vruntime acompanha o menor vruntime dos prontos
+static ALWAYS_INLINE void cfs_update_min(JobReady* ready) {
+    int first = rb_first(ready->fair);
+    if (first >= 0 && rb_key(ready->fair, first) > ready->min_vruntime)
+        ready->min_vruntime = rb_key(ready->fair, first);
+}
+// ======================
+
+// ======== MLFQ =========
+// Os jobs chegam ao nível 0 e descem um nível sempre que gastam o quantum
+// inteiro do seu nível sem acabar; o último nível é um RR. Corre sempre a
+// cabeça do nível mais prioritário e, como no RR, o quantum vai até ao fim
+// (as chegadas esperam por ele). A cada boost_period ticks todos os jobs
+// prontos voltam ao nível 0, para que os longos não fiquem sem CPU.
+MlfqTunables mlfq_tunables = { 3, { 0 }, 100 };
+
+static void mlfq_quanta(int* quanta, int quantum) {
+    if (quantum < 1) quantum = 1;
+    for (int l = 0; l < mlfq_tunables.levels; l++) {
+        long long q = mlfq_tunables.quanta[l] > 0 ? mlfq_tunables.quanta[l] : (long long)quantum << l;
+        quanta[l] = q < INT_MAX ? (int)q : INT_MAX;
+    }
+}
+// =======================
 
-// Mantêm os outros como estavam (podem ser melhorados depois)
-void run_round_robin(ProcessQueue* queue, int quantum) {
-    int current_time = 0, completed = 0;
-    int wait_time = 0, turnaround = 0, total_burst = 0;
-    int* remaining = malloc(sizeof(int) * queue->size);
-    for (int i = 0; i < queue->size; i++) remaining[i] = queue->list[i].burst_time;
+static ALWAYS_INLINE int uses_aging(SchedulingAlgorithm policy) {
+    return policy == PRIORITY_NON_PREEMPTIVE || policy == PRIORITY_PREEMPTIVE;
+}
 
-    printf("\n[RR] Escalonamento com quantum = %d:\n", quantum);
+static ALWAYS_INLINE int ready_empty(const JobReady* ready, SchedulingAlgorithm policy) {
+    if (policy == SJF) return ready->shortest->size == 0;
+    if (policy == CFS) return ready->fair->size == 0;
+    if (policy == MLFQ) return ready->feedback->bitmap == 0;
+    if (uses_aging(policy)) return aging_empty(&ready->ranked);
+    return ready->fifo->size == 0;
+}
 
-    while (completed < queue->size) {
-        int idle = 1;
-        for (int i = 0; i < queue->size; i++) {
-            Process* p = &queue->list[i];
-            if (p->arrival_time <= current_time && remaining[i] > 0) {
-                idle = 0;
-                int exec_time = (remaining[i] > quantum) ? quantum : remaining[i];
-                current_time += exec_time;
-                total_burst += exec_time;
-                remaining[i] -= exec_time;
-                if (remaining[i] == 0) {
-                    int wait = current_time - p->arrival_time - p->burst_time;
-                    int turn = current_time - p->arrival_time;
-                    printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-                    wait_time += wait;
-                    turnaround += turn;
-                    completed++;
-                }
-            }
+// Admite as chegadas até now e devolve o instante da próxima. FCFS e SJF
+// correm também os processos sem burst; Priority e RR ignoram-nos e apenas
+// os contam em skipped.
+static ALWAYS_INLINE long long admit_arrivals(ArrivalSource* src, JobTable* jobs, JobReady* ready,
+                                                   SchedulingAlgorithm policy, long long now,
+                                                   long long* skipped) {
+    long long next;
+    while ((next = source_next_arrival(src)) <= now) {
+        long long seq;
+        Process arrived = source_pop(src, &seq);
+        if (policy == FCFS) {
+            ring_push(ready->fifo, job_admit(jobs, arrived, seq));
+        } else if (policy == SJF) {
+            int slot = job_admit(jobs, arrived, seq);
+            heap_push(ready->shortest, slot, TIE_KEY(arrived.burst_time, seq));
+        } else if (arrived.burst_time <= 0) {
+            (*skipped)++;
+        } else if (policy == ROUND_ROBIN) {
+            ring_push(ready->fifo, job_admit(jobs, arrived, seq));
+        } else if (policy == MLFQ) {
+            mlfq_push(ready->feedback, job_admit(jobs, arrived, seq), 0);
+        } else if (policy == CFS) {
+            ready->fair_weight += cfs_weight(arrived.priority);
+            ring_push(ready->fifo, job_admit(jobs, arrived, seq));
+        } else {
+            // Empates de prioridade resolvem-se pela ordem de chegada (a ordem
+            // das FIFOs de cada nível), e não pelo índice original
+            aging_admit(&ready->ranked, jobs, job_admit(jobs, arrived, src->arrived - 1));
         }
-        if (idle) current_time++;
     }
+    if (policy == CFS && ready->fifo->size) cfs_place_arrivals(ready, jobs);
+    return next;
+}
+
+// Métricas por job de uma execução: espera e turnaround à conclusão,
+// resposta quando o job corre pela primeira vez, e as somas do índice de
+// justiça
+typedef struct {
+    Histogram wait;
+    Histogram turnaround;
+    Histogram response;
+    double slowdown_sum;        // turnaround / burst dos jobs com burst
+    double slowdown_squares;
+    long long slowdown_jobs;
+    long long vruntime_spread;  // CFS: maior diferença de vruntime entre prontos (-1 noutras)
+    long long boosts;           // MLFQ: boosts com jobs em níveis de baixo (-1 noutras)
+} JobMetrics;
+
+// Índice de Jain: (soma x)^2 / (n * soma x^2), entre 1/n e 1
+static float jain_index(const JobMetrics* metrics) {
+    if (metrics->slowdown_squares <= 0) return 0;
+    return (float)(metrics->slowdown_sum * metrics->slowdown_sum /
+                   (metrics->slowdown_jobs * metrics->slowdown_squares));
+}
 
-    float avg_wait = (float)wait_time / queue->size;
-    float avg_turnaround = (float)turnaround / queue->size;
-    float throughput = (float)queue->size / current_time;
-    float cpu_utilization = (float)total_burst / current_time * 100;
-
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f processos/unidade de tempo\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
-    free(remaining);
-}
-
-void run_edf(ProcessQueue* queue) {
-    int* remaining_time = calloc(queue->size, sizeof(int));
-    int* next_release = calloc(queue->size, sizeof(int));
-    int* deadline_misses = calloc(queue->size, sizeof(int));
-    int* current_deadline = malloc(sizeof(int) * queue->size);
-    int total_cpu_time = 0;
-    int current_time = 0;
-    int processos_ativos = 1;  // sinaliza se ainda há processos para simular
-
-    printf("\n[EDF] Escalonamento Real-Time (Dinâmico):\n");
-
-    // Inicializa estruturas
-    for (int i = 0; i < queue->size; i++) {
-        remaining_time[i] = 0;
-        next_release[i] = queue->list[i].arrival_time;
-        current_deadline[i] = next_release[i] + queue->list[i].period;
+static SchedulerStats job_engine_finish(long long current_time, long long horizon, int completed,
+                                        long long skipped, long long wait_time, long long turnaround,
+                                        long long total_burst, long long decisions,
+                                        const JobMetrics* metrics) {
+    long long jobs = completed + skipped;     // chegadas tratadas
+    long long span = horizon != NO_HORIZON ? horizon : current_time;
+
+    float avg_wait = jobs ? (float)wait_time / jobs : 0;
+    float avg_turnaround = jobs ? (float)turnaround / jobs : 0;
+    float throughput = span > 0 ? (float)jobs / span : 0;
+    float cpu_utilization = span > 0 ? (float)total_burst / span * 100 : 0;
+
+    SchedulerStats stats = { completed, avg_wait, avg_turnaround, throughput, cpu_utilization, 0, current_time, decisions };
+    stats.wait_tail = hist_percentiles(&metrics->wait);
+    stats.turnaround_tail = hist_percentiles(&metrics->turnaround);
+    stats.response_tail = hist_percentiles(&metrics->response);
+    stats.fairness = jain_index(metrics);
+
+    LOG("Média de espera: %.2f\n", avg_wait);
+    LOG("Média de turnaround: %.2f\n", avg_turnaround);
+    log_percentiles("Espera", &stats.wait_tail);
+    log_percentiles("Turnaround", &stats.turnaround_tail);
+    log_percentiles("Resposta", &stats.response_tail);
+    LOG("Justiça (índice de Jain do slowdown): %.4f\n", stats.fairness);
+    if (metrics->vruntime_spread >= 0)
+        LOG("Dispersão máxima de vruntime: %.2f ticks\n", (double)metrics->vruntime_spread / VRUNTIME_UNIT);
+    if (metrics->boosts >= 0)
+        LOG("Boosts de prioridade: %lld\n", metrics->boosts);
+    LOG("Throughput: %.2f processos/unidade de tempo\n", throughput);
+    LOG("Utilização da CPU: %.2f%%\n", cpu_utilization);
+    return stats;
+}
+
+// Com horizonte (bounded), um job não-preemptivo que já não acaba antes dele
+// termina a simulação e um preemptivo corre só até lá
+static ALWAYS_INLINE SchedulerStats job_engine(ArrivalSource* src, SchedulingAlgorithm policy, int bounded,
+                                               long long horizon, int quantum) {
+    const int preemptive = policy == PRIORITY_PREEMPTIVE || policy == ROUND_ROBIN || policy == CFS ||
+                           policy == MLFQ;
+    long long current_time = 0;
+    long long wait_time = 0, turnaround = 0, total_burst = 0;
+    long long skipped = 0;
+    long long step = 0;  // passos de aging: ticks (preemptivo) ou decisões
+    long long decisions = 0;
+    int completed = 0;
+
+    JobTable jobs;
+    JobReady ready = { NULL, NULL, { NULL, NULL, NULL, NULL }, NULL, 0, 0, NULL, { 0 } };
+    JobMetrics* metrics = arena_alloc(src->arena, sizeof(JobMetrics));
+    hist_init(&metrics->wait);
+    hist_init(&metrics->turnaround);
+    hist_init(&metrics->response);
+    metrics->slowdown_sum = metrics->slowdown_squares = 0;
+    metrics->slowdown_jobs = 0;
+    metrics->vruntime_spread = policy == CFS ? 0 : -1;
+    metrics->boosts = policy == MLFQ ? 0 : -1;
+    long long vruntime = 0;     // CFS: do job que corre, fora da árvore
+    int level = 0;              // MLFQ: nível de onde saiu o job que corre
+    long long next_boost = policy == MLFQ && mlfq_tunables.boost_period > 0
+                               ? mlfq_tunables.boost_period : NO_HORIZON;
+    job_table_init(&jobs, src->arena, source_capacity(src));
+    if (policy == SJF) ready.shortest = create_ready_heap(src->arena, source_capacity(src));
+    else if (policy == CFS) {
+        ready.fair = create_rb_tree(src->arena, source_capacity(src));
+        ready.fifo = create_ring_queue(src->arena, 16);
     }
+    else if (policy == MLFQ) {
+        ready.feedback = create_mlfq_queues(src->arena, mlfq_tunables.levels, source_capacity(src));
+        mlfq_quanta(ready.quanta, quantum);
+    }
+    else if (uses_aging(policy)) aging_init(&ready.ranked, src->arena, source_capacity(src));
+    else ready.fifo = create_ring_queue(src->arena, source_capacity(src));
+
+    int last = -1;  // job interrompido no evento anterior (-1 se terminou)
+    INSTR_START(t);
+    for (;;) {
+        if (bounded && current_time >= horizon) break;
+        if (policy == MLFQ && current_time >= next_boost) {
+            if (ready.feedback->bitmap > 1) metrics->boosts++;
+            mlfq_boost(ready.feedback);
+            next_boost = (current_time / mlfq_tunables.boost_period + 1) * mlfq_tunables.boost_period;
+        }
+        long long next = admit_arrivals(src, &jobs, &ready, policy, current_time, &skipped);
+        INSTR_LAP(t, PHASE_RELEASE);
+
+        if (ready_empty(&ready, policy)) {
+            if (next == NO_ARRIVAL) break;  // não há mais chegadas (ou só sem burst)
+            long long arrival = next;
+            if (bounded && arrival > horizon) arrival = horizon;
+            INSTR_COUNT(COUNT_IDLE_TICKS, arrival - current_time);
+            current_time = arrival;
+            continue;
+        }
 
-    while (processos_ativos) {
-        processos_ativos = 0;
-        int selected = -1;
-        int earliest_deadline = __INT_MAX__;
-
-        // Libera novos jobs no tempo de chegada
-        for (int i = 0; i < queue->size; i++) {
-            if (current_time == next_release[i]) {
-                if (remaining_time[i] > 0) {
-                    deadline_misses[i]++;
-                    printf("MISS: Processo %d perdeu o deadline anterior!\n", queue->list[i].id);
-                }
-                remaining_time[i] = queue->list[i].burst_time;
-                next_release[i] += queue->list[i].period;
-                current_deadline[i] = next_release[i];
+        if (uses_aging(policy)) {
+            step = policy == PRIORITY_PREEMPTIVE ? current_time : step + 1;
+            while (ready.ranked.waiting->size) {
+                int i = rq_head(ready.ranked.waiting, 0);
+                if (current_time - jobs.jobs[i].arrival_time <= AGING_THRESHOLD) break;
+                aging_start(&ready.ranked, &jobs, i,
+                            policy == PRIORITY_PREEMPTIVE ? jobs.jobs[i].arrival_time + AGING_THRESHOLD + 1 : step,
+                            step);
             }
+            aging_clamp(&ready.ranked, &jobs, step);
+            INSTR_LAP(t, PHASE_AGING);
+        }
 
-            // Se houver algum processo com execução pendente ou aguardando próxima liberação
-            if (remaining_time[i] > 0 || next_release[i] > current_time) {
-                processos_ativos = 1;
+        int idx;
+        if (policy == SJF) {
+            idx = heap_pop(ready.shortest);
+        } else if (policy == CFS) {
+            idx = rb_first(ready.fair);
+            vruntime = rb_key(ready.fair, idx);
+            long long spread = rb_key(ready.fair, rb_last(ready.fair)) - vruntime;
+            if (spread > metrics->vruntime_spread) metrics->vruntime_spread = spread;
+            rb_remove(ready.fair, idx);
+        } else if (policy == MLFQ) {
+            idx = mlfq_pop(ready.feedback, &level);
+        } else if (uses_aging(policy)) {
+            idx = aging_select(&ready.ranked, &jobs, step);
+        } else {
+            idx = ring_pop(ready.fifo);
+        }
+        Process* p = &jobs.jobs[idx];
+        decisions++;
+        // Só corre uma vez com remaining = burst (cada vez no CPU gasta >= 1)
+        if (p->remaining_time == p->burst_time)
+            hist_record(&metrics->response, current_time - p->arrival_time);
+        INSTR_COUNT(COUNT_SELECT_ITERATIONS, 1);
+        if (idx != last) {
+            INSTR_COUNT(COUNT_CONTEXT_SWITCHES, 1);
+            if (last >= 0) INSTR_COUNT(COUNT_PREEMPTIONS, 1);
+        }
+        INSTR_LAP(t, PHASE_SELECT);
+
+        long long run_until = current_time + p->remaining_time;
+        if (policy == ROUND_ROBIN) {
+            if (p->remaining_time > quantum) run_until = current_time + quantum;
+        } else if (policy == CFS) {
+            long long slice = cfs_slice(&ready, cfs_weight(p->priority));
+            if (p->remaining_time > slice) run_until = current_time + slice;
+        } else if (policy == MLFQ) {
+            if (p->remaining_time > ready.quanta[level]) run_until = current_time + ready.quanta[level];
+        } else if (policy == PRIORITY_PREEMPTIVE) {
+            // Corre até ao próximo evento: conclusão, chegada, início do aging
+            // de outro processo, chegada a prioridade 0 ou ultrapassagem pelo
+            // melhor processo em aging (que perde um nível por tick)
+            if (next < run_until) run_until = next;
+            if (ready.ranked.waiting->size) {
+                long long aging_at = jobs.jobs[rq_head(ready.ranked.waiting, 0)].arrival_time + AGING_THRESHOLD + 1;
+                if (aging_at < run_until) run_until = aging_at;
             }
+            if (ready.ranked.aging->size) {
+                long long k = aging_top_k(&ready.ranked, step);
+                if (k < run_until)
+                    run_until = k;
+                if (rq_contains(ready.ranked.young, idx)) {
+                    long long j_seq = jobs.seq[rq_head(ready.ranked.aging, (int)(k & (RQ_LEVELS - 1)))];
+                    long long overtake = k - p->priority + (j_seq < jobs.seq[idx] ? 0 : 1);
+                    if (overtake < run_until) run_until = overtake;
+                }
+            }
+        } else if (bounded && run_until > horizon) {
+            break;
+        }
+        if (preemptive && bounded && run_until > horizon) run_until = horizon;
+
+        if (policy == CFS)
+            vruntime += (run_until - current_time) * CFS_NICE_0_WEIGHT * VRUNTIME_UNIT / cfs_weight(p->priority);
+        // Só desce quem gastou o quantum todo (não quem foi cortado pelo horizonte)
+        if (policy == MLFQ && run_until - current_time == ready.quanta[level] && level + 1 < mlfq_tunables.levels)
+            level++;
+        p->remaining_time -= run_until - current_time;
+        total_burst += run_until - current_time;
+        current_time = run_until;
+        INSTR_LAP(t, PHASE_ACCOUNT);
+
+        if (policy == ROUND_ROBIN || policy == MLFQ) {
+            // Quem chegou durante o quantum fica à frente do processo preemptado.
+            // O slot de p só é libertado depois, para não ser reutilizado aqui.
+            admit_arrivals(src, &jobs, &ready, policy, current_time, &skipped);
+            p = &jobs.jobs[idx];  // job_admit pode ter realocado a tabela
+            INSTR_LAP(t, PHASE_RELEASE);
         }
 
-        // Seleciona o processo com deadline mais próximo
-        for (int i = 0; i < queue->size; i++) {
-            if (remaining_time[i] > 0 && current_deadline[i] < earliest_deadline) {
-                earliest_deadline = current_deadline[i];
-                selected = i;
+        if (p->remaining_time == 0) {
+            int wait = (int)(current_time - p->arrival_time - p->burst_time);
+            int turn = (int)(current_time - p->arrival_time);
+            if (policy == FCFS)
+                LOG_JOB("Processo %d: chegada = %d, Espera = %d, Turnaround = %d\n",
+                        p->id, p->arrival_time, wait, turn);
+            else
+                LOG_JOB("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
+            INSTR_LAP(t, PHASE_OUTPUT);
+            wait_time += wait;
+            turnaround += turn;
+            hist_record(&metrics->wait, wait);
+            hist_record(&metrics->turnaround, turn);
+            if (p->burst_time > 0) {
+                double slowdown = (double)turn / p->burst_time;
+                metrics->slowdown_sum += slowdown;
+                metrics->slowdown_squares += slowdown * slowdown;
+                metrics->slowdown_jobs++;
             }
+            if (uses_aging(policy)) aging_remove(&ready.ranked, idx);
+            if (policy == CFS) ready.fair_weight -= cfs_weight(p->priority);
+            job_retire(&jobs, idx);
+            completed++;
+            last = -1;
+        } else {
+            if (policy == ROUND_ROBIN) ring_push(ready.fifo, idx);
+            if (policy == MLFQ) mlfq_push(ready.feedback, idx, level);
+            if (policy == CFS) rb_insert(ready.fair, idx, vruntime, jobs.seq[idx]);
+            last = idx;
         }
+        if (policy == CFS) cfs_update_min(&ready);
+        INSTR_LAP(t, PHASE_ACCOUNT);
+    }
 
-        if (selected != -1) {
-            remaining_time[selected]--;
-            total_cpu_time++;
-            printf("Tempo %d: Processo %d executando\n", current_time, queue->list[selected].id);
-        } else {
-            printf("Tempo %d: CPU Ociosa\n", current_time);
+    return job_engine_finish(current_time, bounded ? horizon : NO_HORIZON, completed, skipped,
+                             wait_time, turnaround, total_burst, decisions, metrics);
+}
+
+// Quanta do MLFQ por nível, "2/4/8"
+static void format_mlfq_quanta(char* out, size_t size, int quantum) {
+    int quanta[MLFQ_MAX_LEVELS];
+    mlfq_quanta(quanta, quantum);
+    size_t used = 0;
+    for (int l = 0; l < mlfq_tunables.levels && used < size; l++)
+        used += snprintf(out + used, size - used, l ? "/%d" : "%d", quanta[l]);
+}
+
+static void log_job_header(SchedulingAlgorithm algo, long long horizon, int quantum) {
+    const char* mode = algo == PRIORITY_PREEMPTIVE ? "Preemptivo" : "Não-Preemptivo";
+    char quanta[MLFQ_MAX_LEVELS * 12];
+    if (algo == MLFQ) format_mlfq_quanta(quanta, sizeof(quanta), quantum);
+    if (horizon == NO_HORIZON) {
+        switch (algo) {
+            case FCFS: LOG("\n[FCFS] Escalonamento:\n"); break;
+            case SJF: LOG("\n[SJF] Escalonamento:\n"); break;
+            case ROUND_ROBIN: LOG("\n[RR] Escalonamento com quantum = %d:\n", quantum); break;
+            case CFS:
+                LOG("\n[CFS] Escalonamento com latência alvo = %d, granularidade mínima = %d:\n",
+                    cfs_tunables.target_latency, cfs_tunables.min_granularity);
+                break;
+            case MLFQ:
+                LOG("\n[MLFQ] Escalonamento com %d níveis, quanta = %s, boost a cada %d:\n",
+                    mlfq_tunables.levels, quanta, mlfq_tunables.boost_period);
+                break;
+            default: LOG("\n[PRIORITY %s] Escalonamento:\n", mode);
         }
+    } else {
+        switch (algo) {
+            case FCFS: LOG("\n[FCFS STATIC] Tempo limite = %lld\n", horizon); break;
+            case SJF: LOG("\n[SJF STATIC] Tempo limite = %lld\n", horizon); break;
+            case ROUND_ROBIN: LOG("\n[RR-Static] Quantum = %d | Tempo limite = %lld\n", quantum, horizon); break;
+            case CFS:
+                LOG("\n[CFS-Static] Latência alvo = %d | Granularidade mínima = %d | Tempo limite = %lld\n",
+                    cfs_tunables.target_latency, cfs_tunables.min_granularity, horizon);
+                break;
+            case MLFQ:
+                LOG("\n[MLFQ-Static] Níveis = %d | Quanta = %s | Boost = %d | Tempo limite = %lld\n",
+                    mlfq_tunables.levels, quanta, mlfq_tunables.boost_period, horizon);
+                break;
+            default: LOG("\n[PRIORITY STATIC %s] Tempo limite = %lld\n", mode, horizon);
+        }
+    }
+}
+
+// Uma instância do motor por política, com e sem horizonte
+#define JOB_ENGINE(policy) \
+    (horizon != NO_HORIZON ? job_engine(src, policy, 1, horizon, quantum) \
+                           : job_engine(src, policy, 0, NO_HORIZON, quantum))
 
-        current_time++;
+static SchedulerStats run_jobs(ArrivalSource* src, SchedulingAlgorithm algo, int quantum, long long horizon) {
+    log_job_header(algo, horizon, quantum);
+    switch (algo) {
+        case FCFS: return JOB_ENGINE(FCFS);
+        case SJF: return JOB_ENGINE(SJF);
+        case PRIORITY_NON_PREEMPTIVE: return JOB_ENGINE(PRIORITY_NON_PREEMPTIVE);
+        case PRIORITY_PREEMPTIVE: return JOB_ENGINE(PRIORITY_PREEMPTIVE);
+        case CFS: return JOB_ENGINE(CFS);
+        case MLFQ: return JOB_ENGINE(MLFQ);
+        default: return JOB_ENGINE(ROUND_ROBIN);
     }
+}
 
-    // Estatísticas
-    int total_misses = 0;
-    for (int i = 0; i < queue->size; i++)
-        total_misses += deadline_misses[i];
+// Escalonadores de jobs sobre uma carga materializada, com a arena da thread
+static SchedulerStats run_jobs_on_queue(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum,
+                                        long long horizon) {
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    ArrivalSource src;
+    source_from_queue(&src, arena, queue);
+    SchedulerStats stats = run_jobs(&src, algo, quantum, horizon);
+    arena_release(arena, mark);
+    return stats;
+}
 
-    float utilization = (float)total_cpu_time / current_time * 100.0;
-    float throughput = (float)queue->size / current_time;
+SchedulerStats run_fcfs(ProcessQueue* queue) {
+    return run_jobs_on_queue(queue, FCFS, 0, NO_HORIZON);
+}
 
-    printf("\n--- Estatísticas EDF ---\n");
-    printf("Total de deadline misses: %d\n", total_misses);
-    printf("Utilização da CPU: %.2f%%\n", utilization);
-    printf("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
+SchedulerStats run_sjf(ProcessQueue* queue) {
+    return run_jobs_on_queue(queue, SJF, 0, NO_HORIZON);
+}
 
-    free(remaining_time);
-    free(next_release);
-    free(deadline_misses);
-    free(current_deadline);
+SchedulerStats run_priority(ProcessQueue* queue, int preemptive) {
+    return run_jobs_on_queue(queue, preemptive ? PRIORITY_PREEMPTIVE : PRIORITY_NON_PREEMPTIVE, 0, NO_HORIZON);
 }
 
+SchedulerStats run_round_robin(ProcessQueue* queue, int quantum) {
+    return run_jobs_on_queue(queue, ROUND_ROBIN, quantum, NO_HORIZON);
+}
 
-void run_rm(ProcessQueue* queue) {
-    int tempo_total = 100;  // duração da simulação
-    int* remaining_time = calloc(queue->size, sizeof(int));
-    int* next_release = calloc(queue->size, sizeof(int));
-    int* deadline_misses = calloc(queue->size, sizeof(int));
-    int* current_deadline = malloc(sizeof(int) * queue->size);
-    int total_cpu_time = 0;
-    int current_time = 0;
+SchedulerStats run_cfs(ProcessQueue* queue) {
+    return run_jobs_on_queue(queue, CFS, 0, NO_HORIZON);
+}
 
-    printf("\n[RM] Escalonamento Rate Monotonic:\n");
+SchedulerStats run_mlfq(ProcessQueue* queue, int quantum) {
+    return run_jobs_on_queue(queue, MLFQ, quantum, NO_HORIZON);
+}
 
-    // Inicializa tempos
-    for (int i = 0; i < queue->size; i++) {
-        remaining_time[i] = 0;
-        next_release[i] = queue->list[i].arrival_time;
-        current_deadline[i] = next_release[i] + queue->list[i].period;
-    }
+#define PERIODIC_HORIZON 100  // duração da simulação RM/EDF no modo dinâmico
 
-    while (current_time < tempo_total) {
-        int selected = -1;
-        int best_period = __INT_MAX__;
+// total é o número de processos da carga (pode exceder queue->size em
+// streaming, onde só os que chegam antes do horizonte são materializados)
+static SchedulerStats edf_engine(ProcessQueue* queue, long long total) {
+    int tempo_total = PERIODIC_HORIZON;  // duração da simulação (como no RM)
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    ProcessTable* table = create_process_table(arena, queue);
+    PeriodicLatency* latency = create_periodic_latency(arena);
 
-        // Libera novos jobs no tempo de chegada
-        for (int i = 0; i < queue->size; i++) {
-            if (current_time == next_release[i]) {
-                if (remaining_time[i] > 0) {
-                    deadline_misses[i]++;
-                    printf("MISS: Processo %d perdeu o deadline anterior!\n", queue->list[i].id);
-                }
-                remaining_time[i] = queue->list[i].burst_time;
-                next_release[i] += queue->list[i].period;
-                current_deadline[i] = next_release[i];
-            }
-        }
+    LOG("\n[EDF] Escalonamento Real-Time (Dinâmico):\n");
 
-        // Seleciona o processo com menor período (maior prioridade)
-        for (int i = 0; i < queue->size; i++) {
-            if (remaining_time[i] > 0 && queue->list[i].period < best_period) {
-                best_period = queue->list[i].period;
-                selected = i;
-            }
-        }
+    PeriodicResult run = simulate_uniprocessor(table, tempo_total, 1, NULL, latency);
+    int current_time = tempo_total;
 
-        if (selected != -1) {
-            remaining_time[selected]--;
-            total_cpu_time++;
-            printf("Tempo %d: Processo %d executando\n", current_time, queue->list[selected].id);
-        } else {
-            printf("Tempo %d: CPU Ociosa\n", current_time);
-        }
+    // Estatísticas
+    long long total_misses = table_misses(table);
+
+    float utilization = (float)run.cpu_time / current_time * 100.0;
+    float throughput = (float)total / current_time;
+
+    LOG("\n--- Estatísticas EDF ---\n");
+    SchedulerStats stats = { 0, 0, 0, throughput, utilization, total_misses, run.horizon, run.decisions };
+    LOG("Total de deadline misses: %lld\n", total_misses);
+    log_periodic_latency(&stats, latency);
+    LOG("Utilização da CPU: %.2f%%\n", utilization);
+    LOG("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
+    arena_release(arena, mark);
+    return stats;
+}
 
-        current_time++;
-    }
+
+SchedulerStats run_edf(ProcessQueue* queue) {
+    return edf_engine(queue, queue->size);
+}
+
+
+// first_period é o período do primeiro processo gerado (base do throughput)
+static SchedulerStats rm_engine(ProcessQueue* queue, long long total, int first_period) {
+    int tempo_total = PERIODIC_HORIZON;  // duração da simulação
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    ProcessTable* table = create_process_table(arena, queue);
+    PeriodicLatency* latency = create_periodic_latency(arena);
+
+    LOG("\n[RM] Escalonamento Rate Monotonic:\n");
+
+    PeriodicResult run = simulate_uniprocessor(table, tempo_total, 0, NULL, latency);
 
     // Estatísticas finais
-    int total_misses = 0;
-    for (int i = 0; i < queue->size; i++)
-        total_misses += deadline_misses[i];
+    long long total_misses = table_misses(table);
+
+    float utilization = (float)run.cpu_time / tempo_total * 100.0;
+    float throughput = first_period > 0 ? (float)(total * (tempo_total / first_period)) / tempo_total : 0;
+
+    LOG("\n--- Estatísticas RM ---\n");
+    SchedulerStats stats = { 0, 0, 0, throughput, utilization, total_misses, run.horizon, run.decisions };
+    LOG("Total de deadline misses: %lld\n", total_misses);
+    log_periodic_latency(&stats, latency);
+    LOG("Utilização da CPU: %.2f%%\n", utilization);
+    LOG("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
+    arena_release(arena, mark);
+    return stats;
+}
 
-    float utilization = (float)total_cpu_time / tempo_total * 100.0;
-    float throughput = (float)(queue->size * (tempo_total / queue->list[0].period)) / tempo_total;
 
-    printf("\n--- Estatísticas RM ---\n");
-    printf("Total de deadline misses: %d\n", total_misses);
-    printf("Utilização da CPU: %.2f%%\n", utilization);
-    printf("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
+SchedulerStats run_rm(ProcessQueue* queue) {
+    return rm_engine(queue, queue->size, queue->list[0].period);
+}
 
-    free(remaining_time);
-    free(next_release);
-    free(deadline_misses);
-    free(current_deadline);
+// RM/EDF em streaming: as tarefas só são liberadas a partir da chegada, por
+// isso basta materializar as que chegam antes do horizonte
+static SchedulerStats run_periodic_stream(ProcessStream* stream, SchedulingAlgorithm algo) {
+    ProcessQueue* queue = create_process_queue(16);
+    const Process* first = stream_peek(stream);
+    int first_period = first ? first->period : 1;
+    const Process* next;
+
+    while ((next = stream_peek(stream)) && next->arrival_time < PERIODIC_HORIZON)
+        add_process(queue, stream_pop(stream));
+
+    SchedulerStats stats = algo == EDF ? edf_engine(queue, stream->total)
+                                       : rm_engine(queue, stream->total, first_period);
+    destroy_process_queue(queue);
+    return stats;
 }
 
+// Modo STREAM: os processos são gerados à medida que o relógio chega às suas
+// chegadas e os jobs concluídos são retirados, com memória limitada aos jobs
+// vivos em simultâneo
+SchedulerStats run_scheduler_stream(ProcessStream* stream, SchedulingAlgorithm algo, int quantum) {
+    SchedulerStats stats = { 0 };
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    ArrivalSource src;
+    source_from_stream(&src, arena, stream);
 
-void run_scheduler(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum) {
     switch (algo) {
         case FCFS:
-            run_fcfs(queue); break;
         case SJF:
-            run_sjf(queue); break;
         case PRIORITY_PREEMPTIVE:
         case PRIORITY_NON_PREEMPTIVE:
-            run_priority(queue, algo == PRIORITY_PREEMPTIVE); break;
         case ROUND_ROBIN:
-            run_round_robin(queue, quantum); break;
+        case CFS:
+        case MLFQ:
+            stats = run_jobs(&src, algo, quantum, NO_HORIZON);
+            break;
         case RATE_MONOTONIC:
-            run_rm(queue); break;
         case EDF:
-            run_edf(queue); break;
+            stats = run_periodic_stream(stream, algo);
+            break;
         default:
-            printf("Algoritmo não implementado\n");
+            LOG("Algoritmo não implementado\n");
     }
+    arena_release(arena, mark);
+    INSTR_REPORT(algo_name(algo));
+    return stats;
 }
 
 
-//--------IMPLEMENTACAO MODO STATIC--------------
+SchedulerStats run_scheduler(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum) {
+    SchedulerStats stats = { 0 };
 
-void run_scheduler_static(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum, int tempo_total) {
     switch (algo) {
         case FCFS:
-            run_fcfs_static(queue, tempo_total); break;
+            stats = run_fcfs(queue);
+            break;
         case SJF:
-            run_sjf_static(queue, tempo_total); break;
+            stats = run_sjf(queue);
+            break;
         case PRIORITY_PREEMPTIVE:
         case PRIORITY_NON_PREEMPTIVE:
-            run_priority_static(queue, algo == PRIORITY_PREEMPTIVE, tempo_total); break;
+            stats = run_priority(queue, algo == PRIORITY_PREEMPTIVE);
+            break;
         case ROUND_ROBIN:
-            run_round_robin_static(queue, quantum, tempo_total); break;
+            stats = run_round_robin(queue, quantum);
+            break;
+        case CFS:
+            stats = run_cfs(queue);
+            break;
+        case MLFQ:
+            stats = run_mlfq(queue, quantum);
+            break;
         case RATE_MONOTONIC:
-            run_rm_static(queue, tempo_total); break;
+            stats = run_rm(queue);
+            break;
         case EDF:
-            run_edf_static(queue, tempo_total); break;
+            stats = run_edf(queue);
+            break;
         default:
-            printf("Algoritmo (estático) não implementado\n");
+            LOG("Algoritmo não implementado\n");
     }
+    INSTR_REPORT(algo_name(algo));
+    return stats;
 }
 
-void run_fcfs_static(ProcessQueue* queue, int tempo_total) {
-    qsort(queue->list, queue->size, sizeof(Process), compare_by_arrival);
 
-    int current_time = 0;
-    int total_wait = 0, total_turnaround = 0, executed = 0;
+//--------IMPLEMENTACAO MODO STATIC--------------
 
-    printf("\n[FCFS STATIC] Tempo limite = %d\n", tempo_total);
-    for (int i = 0; i < queue->size && current_time < tempo_total; i++) {
-        Process p = queue->list[i];
-        if (current_time < p.arrival_time)
-            current_time = p.arrival_time;
+SchedulerStats run_scheduler_static(ProcessQueue* queue, SchedulingAlgorithm algo, int quantum, long long horizon) {
+    SchedulerStats stats = { 0 };
+    // Só RM/EDF extrapolam horizontes além do int; nos restantes o horizonte
+    // é apenas um limite e todos os processos acabam antes de INT_MAX
+    int tempo_total = horizon < INT_MAX ? (int)horizon : INT_MAX;
 
-        if (current_time + p.burst_time > tempo_total)
+    switch (algo) {
+        case FCFS:
+            stats = run_fcfs_static(queue, tempo_total);
             break;
-
-        int wait_time = current_time - p.arrival_time;
-        int turnaround = wait_time + p.burst_time;
-        current_time += p.burst_time;
-
-        printf("Processo %d: Espera = %d, Turnaround = %d\n", p.id, wait_time, turnaround);
-        total_wait += wait_time;
-        total_turnaround += turnaround;
-        executed++;
+        case SJF:
+            stats = run_sjf_static(queue, tempo_total);
+            break;
+        case PRIORITY_PREEMPTIVE:
+        case PRIORITY_NON_PREEMPTIVE:
+            stats = run_priority_static(queue, algo == PRIORITY_PREEMPTIVE, tempo_total);
+            break;
+        case ROUND_ROBIN:
+            stats = run_round_robin_static(queue, quantum, tempo_total);
+            break;
+        case CFS:
+            stats = run_cfs_static(queue, tempo_total);
+            break;
+        case MLFQ:
+            stats = run_mlfq_static(queue, quantum, tempo_total);
+            break;
+        case RATE_MONOTONIC:
+            stats = run_rm_static(queue, horizon);
+            break;
+        case EDF:
+            stats = run_edf_static(queue, horizon);
+            break;
+        default:
+            LOG("Algoritmo (estático) não implementado\n");
     }
-
-    float avg_wait = executed ? (float)total_wait / executed : 0;
-    float avg_turnaround = executed ? (float)total_turnaround / executed : 0;
-    float throughput = (float)executed / tempo_total;
-    float cpu_utilization = (current_time > tempo_total ? tempo_total : current_time) / tempo_total * 100;
-
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
+    INSTR_REPORT(algo_name(algo));
+    return stats;
 }
 
-void run_sjf_static(ProcessQueue* queue, int tempo_total) {
-    int current_time = 0, completed = 0;
-    int wait_time = 0, turnaround = 0;
-    int* done = calloc(queue->size, sizeof(int));
-
-    printf("\n[SJF STATIC] Tempo limite = %d\n", tempo_total);
-
-    while (completed < queue->size && current_time < tempo_total) {
-        int idx = -1;
-        int min_burst = INT_MAX;
-        for (int i = 0; i < queue->size; i++) {
-            Process* p = &queue->list[i];
-            if (!done[i] && p->arrival_time <= current_time && p->burst_time < min_burst) {
-                min_burst = p->burst_time;
-                idx = i;
-            }
-        }
-
-        if (idx == -1) {
-            current_time++;
-            continue;
-        }
-
-        Process* p = &queue->list[idx];
-        if (current_time + p->burst_time > tempo_total) break;
-
-        int wait = current_time - p->arrival_time;
-        int turn = wait + p->burst_time;
-        current_time += p->burst_time;
-
-        printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-        wait_time += wait;
-        turnaround += turn;
-        done[idx] = 1;
-        completed++;
-    }
-
-    float avg_wait = completed ? (float)wait_time / completed : 0;
-    float avg_turnaround = completed ? (float)turnaround / completed : 0;
-    float throughput = (float)completed / tempo_total;
-    float cpu_utilization = (float)(current_time) / tempo_total * 100;
-
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
-
-    free(done);
+SchedulerStats run_fcfs_static(ProcessQueue* queue, int tempo_total) {
+    return run_jobs_on_queue(queue, FCFS, 0, tempo_total);
 }
 
-void run_priority_static(ProcessQueue* queue, int preemptive, int tempo_total) {
-    int current_time = 0, completed = 0;
-    int wait_time = 0, turnaround = 0;
-    int* remaining = malloc(sizeof(int) * queue->size);
-    int* done = calloc(queue->size, sizeof(int));
-
-    for (int i = 0; i < queue->size; i++)
-        remaining[i] = queue->list[i].burst_time;
-
-    printf("\n[PRIORITY STATIC %s] Tempo limite = %d\n", preemptive ? "Preemptivo" : "Não-Preemptivo", tempo_total);
-
-    while (completed < queue->size && current_time < tempo_total) {
-        int idx = -1;
-        int best_prio = INT_MAX;
-        for (int i = 0; i < queue->size; i++) {
-            Process* p = &queue->list[i];
-            if (!done[i] && p->arrival_time <= current_time && p->priority < best_prio && remaining[i] > 0) {
-                best_prio = p->priority;
-                idx = i;
-            }
-        }
-
-        if (idx == -1) {
-            current_time++;
-            continue;
-        }
-
-        Process* p = &queue->list[idx];
-
-        if (preemptive) {
-            remaining[idx]--;
-            current_time++;
-            if (remaining[idx] == 0) {
-                int wait = current_time - p->arrival_time - p->burst_time;
-                int turn = current_time - p->arrival_time;
-                printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-                wait_time += wait;
-                turnaround += turn;
-                done[idx] = 1;
-                completed++;
-            }
-        } else {
-            if (current_time + p->burst_time > tempo_total) break;
-
-            int wait = current_time - p->arrival_time;
-            current_time += p->burst_time;
-            int turn = current_time - p->arrival_time;
-            printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-            wait_time += wait;
-            turnaround += turn;
-            done[idx] = 1;
-            completed++;
-        }
-    }
-
-    float avg_wait = completed ? (float)wait_time / completed : 0;
-    float avg_turnaround = completed ? (float)turnaround / completed : 0;
-    float throughput = (float)completed / tempo_total;
-    float cpu_utilization = (float)(current_time) / tempo_total * 100;
-
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
-
-    free(remaining);
-    free(done);
+SchedulerStats run_sjf_static(ProcessQueue* queue, int tempo_total) {
+    return run_jobs_on_queue(queue, SJF, 0, tempo_total);
 }
 
-void run_round_robin_static(ProcessQueue* queue, int quantum, int tempo_total) {
-    int current_time = 0, completed = 0;
-    int wait_time = 0, turnaround = 0, total_burst = 0;
-    int* remaining = malloc(sizeof(int) * queue->size);
-    int* last_execution = calloc(queue->size, sizeof(int));
-
-    for (int i = 0; i < queue->size; i++) {
-        remaining[i] = queue->list[i].burst_time;
-        last_execution[i] = -1;
-    }
-
-    printf("\n[RR-Static] Quantum = %d | Tempo limite = %d\n", quantum, tempo_total);
-
-    while (current_time < tempo_total) {
-        int executed_any = 0;
-        for (int i = 0; i < queue->size; i++) {
-            Process* p = &queue->list[i];
-            if (p->arrival_time <= current_time && remaining[i] > 0) {
-                int exec_time = (remaining[i] > quantum) ? quantum : remaining[i];
-                if (current_time + exec_time > tempo_total)
-                    exec_time = tempo_total - current_time;
-
-                current_time += exec_time;
-                total_burst += exec_time;
-                remaining[i] -= exec_time;
-                executed_any = 1;
-
-                if (remaining[i] == 0) {
-                    int wait = current_time - p->arrival_time - p->burst_time;
-                    int turn = current_time - p->arrival_time;
-                    printf("Processo %d: Espera = %d, Turnaround = %d\n", p->id, wait, turn);
-                    wait_time += wait;
-                    turnaround += turn;
-                    completed++;
-                }
-
-                if (current_time >= tempo_total) break;
-            }
-        }
-
-        if (!executed_any) current_time++;
-    }
-
-    float avg_wait = completed ? (float)wait_time / completed : 0;
-    float avg_turnaround = completed ? (float)turnaround / completed : 0;
-    float throughput = (float)completed / tempo_total;
-    float cpu_utilization = (float)total_burst / tempo_total * 100;
-
-    printf("Média de espera: %.2f\n", avg_wait);
-    printf("Média de turnaround: %.2f\n", avg_turnaround);
-    printf("Throughput: %.2f processos/unidade de tempo\n", throughput);
-    printf("Utilização da CPU: %.2f%%\n", cpu_utilization);
-
-    free(remaining);
-    free(last_execution);
+SchedulerStats run_priority_static(ProcessQueue* queue, int preemptive, int tempo_total) {
+    return run_jobs_on_queue(queue, preemptive ? PRIORITY_PREEMPTIVE : PRIORITY_NON_PREEMPTIVE, 0, tempo_total);
 }
 
-void run_rm_static(ProcessQueue* queue, int tempo_total) {
-    int* remaining_time = calloc(queue->size, sizeof(int));
-    int* next_release = calloc(queue->size, sizeof(int));
-    int* deadline_misses = calloc(queue->size, sizeof(int));
-    int* current_deadline = malloc(sizeof(int) * queue->size);
-    int total_cpu_time = 0;
-    int current_time = 0;
-
-    printf("\n[RM-Static] Escalonamento Rate Monotonic | Tempo limite = %d\n", tempo_total);
-
-    for (int i = 0; i < queue->size; i++) {
-        next_release[i] = queue->list[i].arrival_time;
-        current_deadline[i] = next_release[i] + queue->list[i].period;
-    }
-
-    while (current_time < tempo_total) {
-        int selected = -1;
-        int best_period = INT_MAX;
+SchedulerStats run_round_robin_static(ProcessQueue* queue, int quantum, int tempo_total) {
+    return run_jobs_on_queue(queue, ROUND_ROBIN, quantum, tempo_total);
+}
 
-        for (int i = 0; i < queue->size; i++) {
-            if (current_time == next_release[i]) {
-                if (remaining_time[i] > 0) {
-                    deadline_misses[i]++;
-                    printf("MISS: Processo %d perdeu o deadline anterior!\n", queue->list[i].id);
-                }
-                remaining_time[i] = queue->list[i].burst_time;
-                next_release[i] += queue->list[i].period;
-                current_deadline[i] = next_release[i];
-            }
-        }
+SchedulerStats run_cfs_static(ProcessQueue* queue, int tempo_total) {
+    return run_jobs_on_queue(queue, CFS, 0, tempo_total);
+}
 
-        for (int i = 0; i < queue->size; i++) {
-            if (remaining_time[i] > 0 && queue->list[i].period < best_period) {
-                best_period = queue->list[i].period;
-                selected = i;
-            }
-        }
+SchedulerStats run_mlfq_static(ProcessQueue* queue, int quantum, int tempo_total) {
+    return run_jobs_on_queue(queue, MLFQ, quantum, tempo_total);
+}
 
-        if (selected != -1) {
-            remaining_time[selected]--;
-            total_cpu_time++;
-            printf("Tempo %d: Processo %d executando\n", current_time, queue->list[selected].id);
-        } else {
-            printf("Tempo %d: CPU Ociosa\n", current_time);
+// RM/EDF estático. Com checkpoint, retoma de um estado gravado e/ou grava
+// o estado onde a simulação parar (horizonte, stop_at ou sinal).
+static SchedulerStats periodic_static(ProcessQueue* queue, long long tempo_total, int use_deadline,
+                                      const CheckpointConfig* checkpoint) {
+    SchedulerStats none = { 0 };
+    const char* name = use_deadline ? "EDF" : "RM";
+    Arena* arena = thread_arena();
+    ArenaMark mark = arena_mark(arena);
+    ProcessTable* table = create_process_table(arena, queue);
+    PeriodicLatency* latency = create_periodic_latency(arena);
+
+    if (use_deadline)
+        LOG("\n[EDF-Static] Escalonamento Earliest Deadline First | Tempo limite = %lld\n", tempo_total);
+    else
+        LOG("\n[RM-Static] Escalonamento Rate Monotonic | Tempo limite = %lld\n", tempo_total);
+
+    PeriodicResume resume;
+    const PeriodicResume* from = NULL;
+    long long horizon = tempo_total;
+    if (checkpoint && checkpoint->resume_path) {
+        if (load_checkpoint(checkpoint->resume_path, table, use_deadline, &resume) < 0) {
+            arena_release(arena, mark);
+            return none;
         }
-
-        current_time++;
+        LOG("Retomado de %s no instante %lld\n", checkpoint->resume_path, resume.time);
+        from = &resume;
     }
+    if (checkpoint && checkpoint->stop_at > 0 && checkpoint->stop_at < horizon)
+        horizon = checkpoint->stop_at;
 
-    int total_misses = 0;
-    for (int i = 0; i < queue->size; i++)
-        total_misses += deadline_misses[i];
+    PeriodicResult run = simulate_uniprocessor(table, horizon, use_deadline, from, latency);
+    long long total_misses = table_misses(table);
 
-    float utilization = (float)total_cpu_time / tempo_total * 100.0;
-    float throughput = (float)(tempo_total / queue->list[0].period) * queue->size / tempo_total;
-
-    printf("\n--- Estatísticas RM (Static) ---\n");
-    printf("Total de deadline misses: %d\n", total_misses);
-    printf("Utilização da CPU: %.2f%%\n", utilization);
-    printf("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
-
-    free(remaining_time);
-    free(next_release);
-    free(deadline_misses);
-    free(current_deadline);
-}
-
-void run_edf_static(ProcessQueue* queue, int tempo_total) {
-    int* remaining_time = calloc(queue->size, sizeof(int));
-    int* next_release = calloc(queue->size, sizeof(int));
-    int* deadline_misses = calloc(queue->size, sizeof(int));
-    int* current_deadline = malloc(sizeof(int) * queue->size);
-    int total_cpu_time = 0;
-    int current_time = 0;
-
-    printf("\n[EDF-Static] Escalonamento Earliest Deadline First | Tempo limite = %d\n", tempo_total);
-
-    for (int i = 0; i < queue->size; i++) {
-        next_release[i] = queue->list[i].arrival_time;
-        current_deadline[i] = next_release[i] + queue->list[i].period;
+    if (checkpoint && checkpoint->save_path) {
+        PeriodicResume state = { run.horizon, run.clock, run.cpu_time };
+        if (save_checkpoint(checkpoint->save_path, table, use_deadline, &state) == 0)
+            LOG("Checkpoint gravado em %s no instante %lld\n", checkpoint->save_path, run.horizon);
     }
 
-    while (current_time < tempo_total) {
-        int selected = -1;
-        int earliest_deadline = INT_MAX;
-
-        for (int i = 0; i < queue->size; i++) {
-            if (current_time == next_release[i]) {
-                if (remaining_time[i] > 0) {
-                    deadline_misses[i]++;
-                    printf("MISS: Processo %d perdeu o deadline anterior!\n", queue->list[i].id);
-                }
-                remaining_time[i] = queue->list[i].burst_time;
-                next_release[i] += queue->list[i].period;
-                current_deadline[i] = next_release[i];
-            }
-        }
+    // Uma simulação interrompida só cobre até onde chegou
+    long long span = run.interrupted ? run.horizon : horizon;
+    float utilization = run.horizon > 0 ? (float)run.cpu_time / run.horizon * 100.0 : 0;
+    int period = queue->list[0].period;  // 0 se o ficheiro não indicar período
+    float throughput = period > 0 && span > 0 ? (float)(span / period) * queue->size / span : 0;
+
+    LOG("\n--- Estatísticas %s (Static) ---\n", name);
+    SchedulerStats stats = { 0, 0, 0, throughput, utilization, total_misses, run.horizon, run.decisions };
+    LOG("Total de deadline misses: %lld\n", total_misses);
+    log_periodic_latency(&stats, latency);
+    LOG("Utilização da CPU: %.2f%%\n", utilization);
+    LOG("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
+    arena_release(arena, mark);
+    return stats;
+}
 
-        for (int i = 0; i < queue->size; i++) {
-            if (remaining_time[i] > 0 && current_deadline[i] < earliest_deadline) {
-                earliest_deadline = current_deadline[i];
-                selected = i;
-            }
-        }
+SchedulerStats run_rm_static(ProcessQueue* queue, long long tempo_total) {
+    return periodic_static(queue, tempo_total, 0, NULL);
+}
 
-        if (selected != -1) {
-            remaining_time[selected]--;
-            total_cpu_time++;
-            printf("Tempo %d: Processo %d executando\n", current_time, queue->list[selected].id);
-        } else {
-            printf("Tempo %d: CPU Ociosa\n", current_time);
-        }
+SchedulerStats run_edf_static(ProcessQueue* queue, long long tempo_total) {
+    return periodic_static(queue, tempo_total, 1, NULL);
+}
 
-        current_time++;
+SchedulerStats run_periodic_checkpointed(ProcessQueue* queue, SchedulingAlgorithm algo,
+                                         long long tempo_total, const CheckpointConfig* checkpoint) {
+    SchedulerStats none = { 0 };
+    if (algo != RATE_MONOTONIC && algo != EDF) {
+        LOG("Checkpoints só disponíveis para RM/EDF\n");
+        return none;
     }
-
-    int total_misses = 0;
-    for (int i = 0; i < queue->size; i++)
-        total_misses += deadline_misses[i];
-
-    float utilization = (float)total_cpu_time / tempo_total * 100.0;
-    float throughput = (float)(tempo_total / queue->list[0].period) * queue->size / tempo_total;
-
-    printf("\n--- Estatísticas EDF (Static) ---\n");
-    printf("Total de deadline misses: %d\n", total_misses);
-    printf("Utilização da CPU: %.2f%%\n", utilization);
-    printf("Throughput aproximado: %.2f processos/unidade de tempo\n", throughput);
-
-    free(remaining_time);
-    free(next_release);
-    free(deadline_misses);
-    free(current_deadline);
+    SchedulerStats stats = periodic_static(queue, tempo_total, algo == EDF, checkpoint);
+    INSTR_REPORT(algo_name(algo));
+    return stats;
 }
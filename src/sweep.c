@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <pthread.h>
+#include "sweep.h"
+#include "pool.h"
+#include "process.h"
+#include "utils.h"
+#include "output.h"
+
+typedef struct {
+    int seed;
+    SchedulingAlgorithm algo;
+    int quantum;            // -1 se o algoritmo não usa quantum
+    int seed_index;
+    SchedulerStats stats;
+    double elapsed_ms;
+} SweepJob;
+
+// Lista de inteiros no formato "1,4,8" e/ou intervalos "1-100"
+int parse_int_list(const char* str, int** out) {
+    int count = 0, capacity = 16;
+    int* values = malloc(sizeof(int) * capacity);
+    const char* s = str;
+    int valid = 1;
+
+    while (*s) {
+        char* end;
+        long from = strtol(s, &end, 10);
+        if (end == s) { valid = 0; break; }
+        long to = from;
+        if (*end == '-') {
+            s = end + 1;
+            to = strtol(s, &end, 10);
+            if (end == s) { valid = 0; break; }
+        }
+        // Um intervalo invertido ou enorme é um erro, e não uma lista vazia
+        // ou uma alocação de gigabytes
+        if (to < from || from < INT_MIN || to > INT_MAX || to - from >= INT_LIST_MAX - count) {
+            valid = 0;
+            break;
+        }
+        for (long v = from; v <= to; v++) {
+            if (count == capacity) {
+                capacity *= 2;
+                values = realloc(values, sizeof(int) * capacity);
+            }
+            values[count++] = (int)v;
+        }
+        // Lixo depois de um número ("1x5") invalida a lista inteira, em vez
+        // de a cortar em silêncio
+        if (*end != ',' && *end != '\0') { valid = 0; break; }
+        s = (*end == ',') ? end + 1 : end;
+    }
+
+    if (!valid) {
+        free(values);
+        *out = NULL;
+        return 0;
+    }
+    *out = values;
+    return count;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// Carga de uma seed: gerada pela primeira execução que a usa e libertada
+// pela última, para que só as seeds em curso estejam em memória
+typedef struct {
+    pthread_mutex_t lock;
+    ProcessQueue* queue;
+    int pending;            // execuções da seed ainda por terminar
+} SeedWorkload;
+
+typedef struct {
+    const SweepConfig* config;
+    SeedWorkload* workloads;
+    SweepJob* jobs;
+} SweepContext;
+
+int uses_quantum(SchedulingAlgorithm algo) {
+    return algo == ROUND_ROBIN || algo == MLFQ;
+}
+
+// Cada seed tem o seu gerador com estado próprio: as cargas de seeds
+// diferentes geram-se em paralelo, e as execuções da mesma esperam pela sua
+static const ProcessQueue* acquire_workload(SweepContext* ctx, int s) {
+    SeedWorkload* w = &ctx->workloads[s];
+    pthread_mutex_lock(&w->lock);
+    if (!w->queue) {
+        ProcessGenerator gen;
+        init_process_generator(&gen, ctx->config->seeds[s]);
+        w->queue = create_process_queue(ctx->config->num_processes);
+        generate_processes(&gen, w->queue, ctx->config->num_processes);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return w->queue;
+}
+
+static void release_workload(SweepContext* ctx, int s) {
+    SeedWorkload* w = &ctx->workloads[s];
+    pthread_mutex_lock(&w->lock);
+    if (--w->pending == 0) {
+        destroy_process_queue(w->queue);
+        w->queue = NULL;
+    }
+    pthread_mutex_unlock(&w->lock);
+}
+
+// Cada execução trabalha sobre uma cópia privada da carga (alguns
+// escalonadores reordenam a lista)
+static void run_task(void* arg, int j) {
+    SweepContext* ctx = arg;
+    SweepJob* job = &ctx->jobs[j];
+    const ProcessQueue* workload = acquire_workload(ctx, job->seed_index);
+    ProcessQueue queue;
+    queue.size = workload->size;
+    queue.capacity = workload->size;
+    queue.list = malloc(sizeof(Process) * (queue.size > 0 ? queue.size : 1));
+    memcpy(queue.list, workload->list, sizeof(Process) * queue.size);
+    release_workload(ctx, job->seed_index);
+
+    double start = now_ms();
+    job->stats = run_scheduler(&queue, job->algo, job->quantum);
+    job->elapsed_ms = now_ms() - start;
+
+    free(queue.list);
+}
+
+static void write_row(FILE* out, const SweepJob* job, int num_processes, int jsonl) {
+    const SchedulerStats* s = &job->stats;
+    if (jsonl) {
+        fprintf(out, "{\"seed\":%d,\"algo\":\"%s\",\"quantum\":", job->seed, algo_name(job->algo));
+        if (job->quantum >= 0) fprintf(out, "%d", job->quantum);
+        else fprintf(out, "null");
+        fprintf(out, ",\"processes\":%d,\"completed\":%d,\"avg_wait\":%.4f,\"avg_turnaround\":%.4f,"
+                     "\"throughput\":%.4f,\"cpu_utilization\":%.4f,\"deadline_misses\":%lld,"
+                     "\"wait_p50\":%lld,\"wait_p99\":%lld,\"turnaround_p99\":%lld,\"response_p99\":%lld,"
+                     "\"lateness_p99\":%lld,\"fairness\":%.4f,\"elapsed_ms\":%.3f}\n",
+                num_processes, s->completed, s->avg_wait, s->avg_turnaround,
+                s->throughput, s->cpu_utilization, s->deadline_misses,
+                s->wait_tail.p50, s->wait_tail.p99, s->turnaround_tail.p99, s->response_tail.p99,
+                s->lateness_tail.p99, s->fairness, job->elapsed_ms);
+    } else {
+        fprintf(out, "%d,%s,", job->seed, algo_name(job->algo));
+        if (job->quantum >= 0) fprintf(out, "%d", job->quantum);
+        fprintf(out, ",%d,%d,%.4f,%.4f,%.4f,%.4f,%lld,%lld,%lld,%lld,%lld,%lld,%.4f,%.3f\n",
+                num_processes, s->completed, s->avg_wait, s->avg_turnaround,
+                s->throughput, s->cpu_utilization, s->deadline_misses,
+                s->wait_tail.p50, s->wait_tail.p99, s->turnaround_tail.p99, s->response_tail.p99,
+                s->lateness_tail.p99, s->fairness, job->elapsed_ms);
+    }
+}
+
+int run_sweep(const SweepConfig* config, FILE* out) {
+    int n = config->num_processes;
+    int workers = pool_workers(config->threads);
+
+    int saved_verbosity = verbosity;
+    verbosity = VERBOSITY_QUIET;
+
+    int num_jobs = 0;
+    for (int a = 0; a < config->num_algos; a++)
+        num_jobs += config->num_seeds * (uses_quantum(config->algos[a]) ? config->num_quanta : 1);
+
+    SweepContext ctx;
+    ctx.config = config;
+    ctx.workloads = malloc(sizeof(SeedWorkload) * (config->num_seeds > 0 ? config->num_seeds : 1));
+    ctx.jobs = malloc(sizeof(SweepJob) * (num_jobs > 0 ? num_jobs : 1));
+
+    int j = 0;
+    for (int s = 0; s < config->num_seeds; s++) {
+        pthread_mutex_init(&ctx.workloads[s].lock, NULL);
+        ctx.workloads[s].queue = NULL;
+        ctx.workloads[s].pending = 0;
+        for (int a = 0; a < config->num_algos; a++) {
+            int with_quantum = uses_quantum(config->algos[a]);
+            for (int q = 0; q < (with_quantum ? config->num_quanta : 1); q++) {
+                ctx.jobs[j].seed = config->seeds[s];
+                ctx.jobs[j].algo = config->algos[a];
+                ctx.jobs[j].quantum = with_quantum ? config->quanta[q] : -1;
+                ctx.jobs[j].seed_index = s;
+                ctx.workloads[s].pending++;
+                j++;
+            }
+        }
+    }
+
+    pool_run(workers, num_jobs, run_task, &ctx);
+
+    // Uma linha por execução, pela ordem do varrimento
+    if (!config->jsonl)
+        fprintf(out, "seed,algo,quantum,processes,completed,avg_wait,avg_turnaround,"
+                     "throughput,cpu_utilization,deadline_misses,wait_p50,wait_p99,turnaround_p99,"
+                     "response_p99,lateness_p99,fairness,elapsed_ms\n");
+    for (int k = 0; k < num_jobs; k++)
+        write_row(out, &ctx.jobs[k], n, config->jsonl);
+    fflush(out);
+
+    for (int s = 0; s < config->num_seeds; s++)
+        pthread_mutex_destroy(&ctx.workloads[s].lock);
+    free(ctx.workloads);
+    free(ctx.jobs);
+    verbosity = saved_verbosity;
+    return num_jobs;
+}
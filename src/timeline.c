@@ -0,0 +1,60 @@
+#include <stdlib.h>
+#include "timeline.h"
+#include "output.h"
+
+Timeline* create_timeline(int capacity) {
+    Timeline* timeline = malloc(sizeof(Timeline));
+    timeline->capacity = capacity > 0 ? capacity : 1;
+    timeline->segments = malloc(sizeof(Segment) * timeline->capacity);
+    timeline->size = 0;
+    return timeline;
+}
+
+void destroy_timeline(Timeline* timeline) {
+    free(timeline->segments);
+    free(timeline);
+}
+
+void timeline_append(Timeline* timeline, int start, int end, int pid, int misses) {
+    if (start >= end) return;
+    if (timeline->size > 0 && misses == 0) {
+        Segment* last = &timeline->segments[timeline->size - 1];
+        if (last->pid == pid && last->end == start && !last->preempted) {
+            last->end = end;
+            return;
+        }
+    }
+
+    if (timeline->size == timeline->capacity) {
+        timeline->capacity *= 2;
+        timeline->segments = realloc(timeline->segments, sizeof(Segment) * timeline->capacity);
+    }
+    Segment* seg = &timeline->segments[timeline->size++];
+    seg->start = start;
+    seg->end = end;
+    seg->pid = pid;
+    seg->misses = misses;
+    seg->preempted = false;
+}
+
+void timeline_mark_preempted(Timeline* timeline) {
+    if (timeline->size > 0)
+        timeline->segments[timeline->size - 1].preempted = true;
+}
+
+// Diagrama de Gantt em texto: um segmento por linha
+void print_timeline(const Timeline* timeline) {
+    out_printf("Linha temporal (%d segmentos):\n", timeline->size);
+    for (int i = 0; i < timeline->size; i++) {
+        const Segment* seg = &timeline->segments[i];
+        if (seg->pid >= 0)
+            out_printf("[%d, %d) Processo %d", seg->start, seg->end, seg->pid);
+        else
+            out_printf("[%d, %d) CPU Ociosa", seg->start, seg->end);
+        if (seg->misses > 0)
+            out_printf(" | %d deadline(s) perdido(s) em %d", seg->misses, seg->start);
+        if (seg->preempted)
+            out_printf(" | preemptado");
+        out_printf("\n");
+    }
+}
@@ -0,0 +1,103 @@
+#include <string.h>
+#include <limits.h>
+#include "timerwheel.h"
+
+TimerWheel* create_timer_wheel(Arena* arena, int capacity, int now) {
+    TimerWheel* wheel = arena_alloc(arena, sizeof(TimerWheel));
+    wheel->next = arena_alloc(arena, sizeof(int) * (capacity > 0 ? capacity : 1));
+    wheel->when = arena_alloc(arena, sizeof(int) * (capacity > 0 ? capacity : 1));
+    wheel->capacity = capacity;
+    for (int i = 0; i < capacity; i++)
+        wheel->when[i] = -1;
+    wheel->size = 0;
+    wheel_reset(wheel, now);
+    return wheel;
+}
+
+void wheel_reset(TimerWheel* wheel, int now) {
+    if (wheel->size) {
+        for (int i = 0; i < wheel->capacity; i++)
+            wheel->when[i] = -1;
+        wheel->size = 0;
+    }
+    memset(wheel->bitmap, 0, sizeof(wheel->bitmap));
+    memset(wheel->head, -1, sizeof(wheel->head));
+    wheel->now = now;
+    wheel->next_due = INT_MAX;
+}
+
+// Nível do primeiro dígito em que when difere de now
+static int wheel_level(int now, int when) {
+    unsigned diff = (unsigned)when ^ (unsigned)now;
+    if (diff < WHEEL_SLOTS) return 0;
+    return (31 - __builtin_clz(diff)) / WHEEL_BITS;
+}
+
+static void wheel_insert(TimerWheel* wheel, int id, int when) {
+    int level = wheel_level(wheel->now, when);
+    int slot = (when >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+    wheel->next[id] = wheel->head[level][slot];
+    wheel->head[level][slot] = id;
+    wheel->bitmap[level] |= 1ULL << slot;
+}
+
+void wheel_schedule(TimerWheel* wheel, int id, int when) {
+    wheel->when[id] = when;
+    wheel->size++;
+    wheel_insert(wheel, id, when);
+    if (wheel->next_due >= 0 && when < wheel->next_due) wheel->next_due = when;
+}
+
+// Os temporizadores de um nível estão todos depois dos dos níveis abaixo:
+// o mínimo está na primeira ranhura ocupada do nível mais baixo com alguma.
+// No nível 0 a ranhura dá o instante exato; acima percorre-se a lista.
+int wheel_next(TimerWheel* wheel) {
+    if (wheel->next_due >= 0) return wheel->next_due;
+    int due = INT_MAX;
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        if (!wheel->bitmap[level]) continue;
+        int slot = __builtin_ctzll(wheel->bitmap[level]);
+        if (level == 0) {
+            due = (wheel->now & ~(WHEEL_SLOTS - 1)) | slot;
+        } else {
+            for (int id = wheel->head[level][slot]; id != -1; id = wheel->next[id])
+                if (wheel->when[id] < due) due = wheel->when[id];
+        }
+        break;
+    }
+    wheel->next_due = due;
+    return due;
+}
+
+int wheel_advance(TimerWheel* wheel, int time, int* due) {
+    // Com time <= próximo vencimento, os níveis abaixo do primeiro dígito
+    // que muda estão vazios e nesse nível só a ranhura de time desce
+    if (time != wheel->now) {
+        int level = wheel_level(wheel->now, time);
+        wheel->now = time;
+        if (level > 0) {
+            int slot = (time >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+            int id = wheel->head[level][slot];
+            wheel->head[level][slot] = -1;
+            wheel->bitmap[level] &= ~(1ULL << slot);
+            while (id != -1) {
+                int next = wheel->next[id];
+                wheel_insert(wheel, id, wheel->when[id]);
+                id = next;
+            }
+        }
+    }
+
+    int slot = time & (WHEEL_SLOTS - 1);
+    if (!(wheel->bitmap[0] & (1ULL << slot))) return 0;
+    int count = 0;
+    for (int id = wheel->head[0][slot]; id != -1; id = wheel->next[id]) {
+        wheel->when[id] = -1;
+        due[count++] = id;
+    }
+    wheel->head[0][slot] = -1;
+    wheel->bitmap[0] &= ~(1ULL << slot);
+    wheel->size -= count;
+    wheel->next_due = -1;
+    return count;
+}
@@ -0,0 +1,425 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include "trace.h"
+#include "output.h"
+
+#define TRACE_BUFFER (4 << 20)   // leituras de 4 MiB
+
+typedef struct {
+    int pid;                    // 0 = entrada vazia
+    int prio;                   // prioridade do kernel (120 = nice 0)
+    long long job;              // sequência do job aberto, -1 se nenhum
+    long long running_since;    // us, -1 se não está no CPU
+} TaskEntry;
+
+typedef struct {
+    int pid;
+    int prio;
+    long long arrival;          // us
+    long long run;              // us no CPU até agora
+    int closed;
+} PendingJob;
+
+struct TraceReader {
+    int fd;
+    char* buffer;
+    size_t start, end;          // bytes por processar: buffer[start, end)
+    int eof;                    // read devolveu 0 (ou erro)
+    int finished;               // jobs abertos fechados no fim do trace
+    int tick_us;
+
+    long long base;             // instante do primeiro evento (us), -1 antes dele
+    long long now;
+    long long last_arrival;     // as chegadas nunca recuam
+
+    TaskEntry* tasks;           // tabela de dispersão por pid
+    int task_capacity;
+    int task_count;
+
+    PendingJob* pending;        // anel de TRACE_PENDING jobs por ordem de chegada
+    long long head, tail;       // sequências ainda por entregar: [head, tail)
+
+    long long bytes, events, jobs, splits, empty;
+    int overflow;               // chegadas além do int: o resto é ignorado
+    double seconds;             // tempo passado em trace_read
+};
+
+TraceReader* open_trace(const char* path, int tick_us) {
+    int fd = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("Erro ao abrir trace");
+        return NULL;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    TraceReader* trace = calloc(1, sizeof(TraceReader));
+    trace->fd = fd;
+    trace->buffer = malloc(TRACE_BUFFER);
+    trace->tick_us = tick_us > 0 ? tick_us : 1;
+    trace->base = -1;
+    trace->task_capacity = 1024;
+    trace->tasks = calloc(trace->task_capacity, sizeof(TaskEntry));
+    trace->pending = malloc(sizeof(PendingJob) * TRACE_PENDING);
+    return trace;
+}
+
+void close_trace(TraceReader* trace) {
+    if (trace->fd != STDIN_FILENO) close(trace->fd);
+    free(trace->buffer);
+    free(trace->tasks);
+    free(trace->pending);
+    free(trace);
+}
+
+// ======== TAREFAS =========
+static void grow_tasks(TraceReader* trace) {
+    TaskEntry* old = trace->tasks;
+    int old_capacity = trace->task_capacity;
+    trace->task_capacity *= 2;
+    trace->tasks = calloc(trace->task_capacity, sizeof(TaskEntry));
+    for (int i = 0; i < old_capacity; i++) {
+        if (!old[i].pid) continue;
+        unsigned h = ((unsigned)old[i].pid * 2654435761u) & (trace->task_capacity - 1);
+        while (trace->tasks[h].pid) h = (h + 1) & (trace->task_capacity - 1);
+        trace->tasks[h] = old[i];
+    }
+    free(old);
+}
+
+// Entrada do pid, criada se ainda não existir. O ponteiro só é válido até
+// à próxima procura (a tabela pode crescer).
+static TaskEntry* find_task(TraceReader* trace, int pid) {
+    if (2 * (trace->task_count + 1) > trace->task_capacity) grow_tasks(trace);
+    unsigned h = ((unsigned)pid * 2654435761u) & (trace->task_capacity - 1);
+    while (trace->tasks[h].pid && trace->tasks[h].pid != pid)
+        h = (h + 1) & (trace->task_capacity - 1);
+    TaskEntry* task = &trace->tasks[h];
+    if (!task->pid) {
+        task->pid = pid;
+        task->prio = 120;
+        task->job = -1;
+        task->running_since = -1;
+        trace->task_count++;
+    }
+    return task;
+}
+
+static PendingJob* pending_job(TraceReader* trace, long long seq) {
+    return &trace->pending[seq & (TRACE_PENDING - 1)];
+}
+
+// Soma ao job aberto o tempo no CPU desde a última conta
+static void charge_running(TraceReader* trace, TaskEntry* task) {
+    if (task->running_since < 0) return;
+    if (task->job >= 0 && trace->now > task->running_since)
+        pending_job(trace, task->job)->run += trace->now - task->running_since;
+    task->running_since = trace->now;
+}
+
+static void open_job(TraceReader* trace, TaskEntry* task) {
+    PendingJob* job = pending_job(trace, trace->tail);
+    job->pid = task->pid;
+    job->prio = task->prio;
+    job->arrival = trace->now > trace->last_arrival ? trace->now : trace->last_arrival;
+    job->run = 0;
+    job->closed = 0;
+    trace->last_arrival = job->arrival;
+    task->job = trace->tail++;
+}
+
+static void close_job(TraceReader* trace, TaskEntry* task) {
+    pending_job(trace, task->job)->closed = 1;
+    task->job = -1;
+}
+
+// O job mais antigo segura todos os outros: fecha-o com o que correu até
+// agora. A tarefa fica sem job e o resto do burst abre um job novo no seu
+// próximo evento (não aqui, para que o anel esvazie).
+static void split_head(TraceReader* trace) {
+    TaskEntry* task = find_task(trace, pending_job(trace, trace->head)->pid);
+    charge_running(trace, task);
+    close_job(trace, task);
+    trace->splits++;
+}
+
+// Fim do trace: os jobs abertos acabam no último instante
+static void finish_jobs(TraceReader* trace) {
+    for (long long seq = trace->head; seq < trace->tail; seq++) {
+        PendingJob* job = pending_job(trace, seq);
+        if (job->closed) continue;
+        TaskEntry* task = find_task(trace, job->pid);
+        charge_running(trace, task);
+        close_job(trace, task);
+    }
+    trace->finished = 1;
+}
+// ==========================
+
+// ======== EVENTOS =========
+static void on_wakeup(TraceReader* trace, int pid, int prio) {
+    if (pid <= 0) return;
+    TaskEntry* task = find_task(trace, pid);
+    if (prio >= 0) task->prio = prio;
+    if (task->job < 0) open_job(trace, task);
+}
+
+// prev_runnable: a tarefa que sai foi preemptada (estado R) e o job continua
+static void on_switch(TraceReader* trace, int prev_pid, int prev_runnable, int next_pid, int next_prio) {
+    if (prev_pid > 0) {
+        TaskEntry* task = find_task(trace, prev_pid);
+        if (task->job < 0 && task->running_since >= 0) open_job(trace, task);   // job partido
+        charge_running(trace, task);
+        task->running_since = -1;
+        if (!prev_runnable && task->job >= 0) close_job(trace, task);
+    }
+    if (next_pid > 0) {
+        TaskEntry* task = find_task(trace, next_pid);
+        if (next_prio >= 0) task->prio = next_prio;
+        if (task->job < 0) open_job(trace, task);   // já corria antes do trace
+        pending_job(trace, task->job)->prio = task->prio;
+        task->running_since = trace->now;
+    }
+}
+// ==========================
+
+// ======== PARSER =========
+// Primeira ocorrência de key em [p, end), ou NULL
+static const char* find_key(const char* p, const char* end, const char* key, size_t len) {
+    while ((size_t)(end - p) >= len && (p = memchr(p, key[0], end - p - len + 1))) {
+        if (memcmp(p, key, len) == 0) return p;
+        p++;
+    }
+    return NULL;
+}
+
+#define FIND(p, end, key) find_key(p, end, key, sizeof(key) - 1)
+#define STARTS(p, end, key) ((size_t)((end) - (p)) >= sizeof(key) - 1 && memcmp(p, key, sizeof(key) - 1) == 0)
+
+static int is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Inteiro sem sinal em p (-1 se não houver dígitos)
+static int parse_number(const char* p, const char* end) {
+    if (p >= end || !is_digit(*p)) return -1;
+    long long v = 0;
+    while (p < end && is_digit(*p) && v <= INT_MAX)
+        v = v * 10 + (*p++ - '0');
+    return v <= INT_MAX ? (int)v : -1;
+}
+
+// Valor de "key=" em [p, end) (-1 se não existir)
+static int key_value(const char* p, const char* end, const char* key, size_t len) {
+    const char* at = find_key(p, end, key, len);
+    return at ? parse_number(at + len, end) : -1;
+}
+
+#define KEY_VALUE(p, end, key) key_value(p, end, key, sizeof(key) - 1)
+
+// Formato compacto do libtraceevent, "comm:pid [prio]" terminado em close:
+// o último '[' antes de close dá a prioridade e os dígitos antes dele o pid
+// (-1 se a tarefa não estiver completa, por exemplo sem close)
+static int compact_task(const char* p, const char* close, int* prio) {
+    *prio = -1;
+    if (!close || close <= p) return -1;
+    const char* bracket = close;
+    while (bracket > p && *bracket != '[') bracket--;
+    if (*bracket != '[' || bracket - p < 2 || bracket[-1] != ' ') return -1;
+    *prio = parse_number(bracket + 1, close + 1);
+    const char* digits = bracket - 1;
+    while (digits > p && is_digit(digits[-1])) digits--;
+    if (digits == p || digits[-1] != ':') return -1;
+    return parse_number(digits, bracket - 1);
+}
+
+// Instante "segundos.fração" em us
+static long long parse_timestamp(const char* p, const char* end) {
+    long long us = 0;
+    while (p < end && is_digit(*p))
+        us = us * 10 + (*p++ - '0');
+    us *= 1000000;
+    if (p < end && *p == '.') p++;
+    long long scale = 100000;
+    while (p < end && is_digit(*p) && scale > 0) {
+        us += (*p++ - '0') * scale;
+        scale /= 10;
+    }
+    return us;
+}
+
+static void parse_event(TraceReader* trace, const char* p, const char* end) {
+    // O instante é o número antes do primeiro ": " precedido de um dígito
+    const char* colon = p;
+    for (;;) {
+        colon = memchr(colon, ':', end - colon);
+        if (!colon || colon + 1 >= end) return;
+        if (colon[1] == ' ' && colon > p && is_digit(colon[-1])) break;
+        colon++;
+    }
+    const char* ts = colon;
+    while (ts > p && (is_digit(ts[-1]) || ts[-1] == '.')) ts--;
+
+    const char* e = colon + 2;
+    while (e < end && (*e == ' ' || is_digit(*e))) e++;     // período do perf, se houver
+    if (STARTS(e, end, "sched:")) e += 6;
+    if (!STARTS(e, end, "sched_")) return;
+
+    int is_switch = STARTS(e, end, "sched_switch:");
+    int is_wakeup = STARTS(e, end, "sched_wakeup:") || STARTS(e, end, "sched_wakeup_new:") ||
+                    STARTS(e, end, "sched_waking:");
+    if (!is_switch && !is_wakeup) return;
+    const char* args = memchr(e, ':', end - e) + 1;
+
+    trace->now = parse_timestamp(ts, colon);
+    if (trace->base < 0) trace->base = trace->last_arrival = trace->now;
+    trace->events++;
+
+    if (is_wakeup) {
+        int pid = KEY_VALUE(args, end, " pid=");
+        int prio;
+        if (pid >= 0) prio = KEY_VALUE(args, end, " prio=");
+        else pid = compact_task(args, memchr(args, ']', end - args), &prio);
+        if (pid < 0) return;    // linha malformada ou cortada
+        on_wakeup(trace, pid, prio);
+        return;
+    }
+
+    const char* arrow = FIND(args, end, " ==> ");
+    if (!arrow) return;
+    int prev_pid, next_pid, next_prio, prev_runnable;
+    const char* state = FIND(args, arrow, "prev_state=");
+    if (state) {
+        prev_pid = KEY_VALUE(args, arrow, "prev_pid=");
+        state += sizeof("prev_state=") - 1;
+        next_pid = KEY_VALUE(arrow, end, "next_pid=");
+        next_prio = KEY_VALUE(arrow, end, "next_prio=");
+    } else {
+        // "prev_comm:prev_pid [prio] S ==> next_comm:next_pid [prio]"
+        const char* close = arrow;
+        while (close > args && *close != ']') close--;
+        int prio;
+        prev_pid = compact_task(args, close, &prio);
+        state = close + 1;
+        while (state < arrow && *state == ' ') state++;
+        close = end - 1;
+        while (close > arrow && *close != ']') close--;
+        next_pid = compact_task(arrow, close, &next_prio);
+    }
+    prev_runnable = state < end && (*state == 'R' || *state == '0');
+    on_switch(trace, prev_pid, prev_runnable, next_pid, next_prio);
+}
+
+// Próxima linha (sem o '\n') em [*line, *line_end); 0 no fim do ficheiro
+static int next_line(TraceReader* trace, const char** line, const char** line_end) {
+    for (;;) {
+        char* data = trace->buffer + trace->start;
+        char* newline = memchr(data, '\n', trace->end - trace->start);
+        if (newline) {
+            *line = data;
+            *line_end = newline;
+            trace->start = newline + 1 - trace->buffer;
+            return 1;
+        }
+        if (trace->eof) {
+            if (trace->start == trace->end) return 0;
+            *line = data;
+            *line_end = trace->buffer + trace->end;
+            trace->start = trace->end;
+            return 1;
+        }
+
+        // Guarda o resto da linha e lê mais; uma linha maior que o bloco
+        // inteiro é descartada
+        memmove(trace->buffer, data, trace->end - trace->start);
+        trace->end -= trace->start;
+        trace->start = 0;
+        if (trace->end == TRACE_BUFFER) trace->end = 0;
+        ssize_t n = read(trace->fd, trace->buffer + trace->end, TRACE_BUFFER - trace->end);
+        if (n < 0) perror("Erro ao ler trace");
+        if (n <= 0) trace->eof = 1;
+        else {
+            trace->end += n;
+            trace->bytes += n;
+        }
+    }
+}
+// ==========================
+
+static int to_ticks(long long us, int tick_us) {
+    long long ticks = us / tick_us;
+    return ticks < INT_MAX ? (int)ticks : INT_MAX;
+}
+
+static int nice_of(int prio) {
+    if (prio < 100) return -20;
+    int nice = prio - 120;
+    return nice < -20 ? -20 : nice > 19 ? 19 : nice;
+}
+
+// Converte o job mais antigo (fechado); 0 se não correu nada
+static int emit_job(TraceReader* trace, Process* out) {
+    PendingJob* job = pending_job(trace, trace->head++);
+    if (job->run == 0) {
+        trace->empty++;
+        return 0;
+    }
+    long long arrival = (job->arrival - trace->base) / trace->tick_us;
+    if (arrival > INT_MAX) {
+        trace->overflow = 1;
+        return 0;
+    }
+    out->id = job->pid;
+    out->arrival_time = (int)arrival;
+    out->burst_time = to_ticks(job->run + trace->tick_us / 2, trace->tick_us);
+    if (out->burst_time == 0) out->burst_time = 1;
+    out->priority = nice_of(job->prio);
+    out->remaining_time = out->burst_time;
+    out->period = 0;
+    out->deadline = out->arrival_time;
+    trace->jobs++;
+    return 1;
+}
+
+int trace_read(TraceReader* trace, Process* out, int max) {
+    struct timespec start, stop;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int count = 0;
+    while (count < max && !trace->overflow) {
+        // Entrega os jobs já fechados, por ordem de chegada
+        if (trace->head < trace->tail && pending_job(trace, trace->head)->closed) {
+            count += emit_job(trace, &out[count]);
+            continue;
+        }
+        // Um evento abre no máximo dois jobs (o resto de um partido e o seguinte)
+        if (trace->tail - trace->head > TRACE_PENDING - 2) {
+            split_head(trace);
+            continue;
+        }
+        if (trace->finished) break;
+
+        const char* line;
+        const char* line_end;
+        if (next_line(trace, &line, &line_end)) parse_event(trace, line, line_end);
+        else finish_jobs(trace);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    trace->seconds += (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+    return count;
+}
+
+void log_trace_summary(const TraceReader* trace) {
+    double mb = trace->bytes / 1e6;
+    LOG("Trace: %.1f MB, %lld eventos, %lld jobs (%lld partidos, %lld sem CPU ignorados), "
+        "%d tarefas, leitura a %.0f MB/s\n",
+        mb, trace->events, trace->jobs, trace->splits, trace->empty, trace->task_count,
+        trace->seconds > 0 ? mb / trace->seconds : 0);
+    if (trace->overflow)
+        LOG("Aviso: trace truncado, chegadas além de %d ticks\n", INT_MAX);
+}
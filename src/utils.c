@@ -1,29 +1,251 @@
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "utils.h"
+#include "instrument.h"
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(RngState* rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++)
+        rng->s[i] = splitmix64(&seed);
+}
+
+void rng_jump(RngState* rng) {
+    static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                     0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    uint64_t s[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (1ULL << b)) {
+                for (int k = 0; k < 4; k++)
+                    s[k] ^= rng->s[k];
+            }
+            rng_next(rng);
+        }
+    }
+    memcpy(rng->s, s, sizeof(s));
+}
+
+// ======== FUNÇÕES MATEMÁTICAS VETORIZÁVEIS =========
+// Sem chamadas à libm nem ramificações, para o compilador conseguir vetorizar
+// os ciclos dos kernels em lote. Erro relativo da ordem de 1e-14.
+
+// log(x) para x normal e positivo: x = m * 2^e com m em [sqrt(1/2), sqrt(2)),
+// log(m) = 2 * atanh(s) com s = (m - 1) / (m + 1)
+static inline double fast_log(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    int64_t e = (int64_t)((bits >> 52) & 0x7ff) - 1023;
+    bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+    double m;
+    memcpy(&m, &bits, sizeof(m));
+    int adjust = m > M_SQRT2;
+    m = adjust ? m * 0.5 : m;
+    e += adjust;
+
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double p = 1.0 / 17;
+    p = p * s2 + 1.0 / 15;
+    p = p * s2 + 1.0 / 13;
+    p = p * s2 + 1.0 / 11;
+    p = p * s2 + 1.0 / 9;
+    p = p * s2 + 1.0 / 7;
+    p = p * s2 + 1.0 / 5;
+    p = p * s2 + 1.0 / 3;
+    p = p * s2 + 1.0;
+    return (double)e * M_LN2 + 2.0 * s * p;
+}
+
+// sin(2πu) e cos(2πu) para u em [0, 1): reduz a |x| <= 1/4 e usa Taylor
+static inline void fast_sincos_2pi(double u, double* sin_out, double* cos_out) {
+    double x = u < 0.5 ? u : u - 1.0;          // [-1/2, 1/2)
+    int flip = x > 0.25 || x < -0.25;          // sin(π - a) = sin a, cos(π - a) = -cos a
+    double half = x > 0 ? 0.5 : -0.5;
+    x = flip ? half - x : x;
+    double a = 2.0 * M_PI * x;                 // [-π/2, π/2]
+    double a2 = a * a;
+
+    double s = 1.0 / 355687428096000.0;        // 1/17!
+    s = s * -a2 + 1.0 / 1307674368000.0;
+    s = s * -a2 + 1.0 / 6227020800.0;
+    s = s * -a2 + 1.0 / 39916800.0;
+    s = s * -a2 + 1.0 / 362880.0;
+    s = s * -a2 + 1.0 / 5040.0;
+    s = s * -a2 + 1.0 / 120.0;
+    s = s * -a2 + 1.0 / 6.0;
+    s = s * -a2 + 1.0;
+
+    double c = 1.0 / 6402373705728000.0;       // 1/18!
+    c = c * -a2 + 1.0 / 20922789888000.0;
+    c = c * -a2 + 1.0 / 87178291200.0;
+    c = c * -a2 + 1.0 / 479001600.0;
+    c = c * -a2 + 1.0 / 3628800.0;
+    c = c * -a2 + 1.0 / 40320.0;
+    c = c * -a2 + 1.0 / 720.0;
+    c = c * -a2 + 1.0 / 24.0;
+    c = c * -a2 + 0.5;
+    c = c * -a2 + 1.0;
+
+    *sin_out = a * s;
+    *cos_out = flip ? -c : c;
+}
+
+// log(k!) exato para k pequeno, série de Stirling para o resto
+static double log_factorial(double k) {
+    static const double table[10] = {
+        0.0, 0.0, 0.69314718055994531, 1.79175946922805500,
+        3.17805383034794562, 4.78749174278204599, 6.57925121201010100,
+        8.52516136106541430, 10.60460290274525023, 12.80182748008146961
+    };
+    if (k < 10) return table[(int)k];
+    double x = k + 1.0;
+    double x2 = x * x;
+    return (x - 0.5) * log(x) - x + 0.91893853320467274178
+         + (1.0 / 12 - (1.0 / 360 - 1.0 / (1260 * x2)) / x2) / x;
+}
+// ==================================================
+
+// Mesma conta que fill_exponential, para o resultado não depender do caminho
+double rng_exponential(RngState* rng, double lambda) {
+    return fast_log(1.0 - rng_uniform(rng)) * (-1.0 / lambda);
+}
+
+double rng_normal(RngState* rng, double mean, double std_dev) {
+    double u1 = 1.0 - rng_uniform(rng);   // (0, 1]
+    double u2 = rng_uniform(rng);
+    double s, c;
+    fast_sincos_2pi(u2, &s, &c);
+    return sqrt(-2.0 * fast_log(u1)) * c * std_dev + mean;
+}
+
+// Poisson: multiplicação de uniformes para lambda pequeno (O(lambda)) e
+// PTRS (Hörmann, transformed rejection with squeeze) para lambda >= 10,
+// com custo esperado O(1) independente de lambda
+double rng_poisson(RngState* rng, double lambda) {
+    if (lambda < 10) {
+        double L = exp(-lambda);
+        double p = 1.0;
+        int k = 0;
+        do {
+            k++;
+            p *= rng_uniform(rng);
+        } while (p > L);
+        return k - 1;
+    }
+
+    double slam = sqrt(lambda);
+    double loglam = log(lambda);
+    double b = 0.931 + 2.53 * slam;
+    double a = -0.059 + 0.02483 * b;
+    double inv_alpha = 1.1239 + 1.1328 / (b - 3.4);
+    double vr = 0.9277 - 3.6224 / (b - 2);
+
+    for (;;) {
+        double u = rng_uniform(rng) - 0.5;
+        double v = rng_uniform(rng);
+        double us = 0.5 - fabs(u);
+        double k = floor((2 * a / us + b) * u + lambda + 0.43);
+        if (us >= 0.07 && v <= vr)
+            return k;
+        if (k < 0 || (us < 0.013 && v > us))
+            continue;
+        if (log(v) + log(inv_alpha) - log(a / (us * us) + b) <= -lambda + k * loglam - log_factorial(k))
+            return k;
+    }
+}
+
+void fill_uniform(RngState* rng, double* out, int n) {
+    for (int i = 0; i < n; i++)
+        out[i] = rng_uniform(rng);
+}
+
+// Os geradores em lote e os de valor único são instrumentados (instrument.h);
+// fill_uniform conta dentro dos que o usam
+void fill_exponential(RngState* rng, double lambda, double* out, int n) {
+    INSTR_START(t);
+    double scale = -1.0 / lambda;
+    fill_uniform(rng, out, n);
+    for (int i = 0; i < n; i++)
+        out[i] = fast_log(1.0 - out[i]) * scale;
+    INSTR_COUNT(COUNT_RNG_DRAWS, n);
+    INSTR_LAP(t, PHASE_GENERATE);
+}
+
+// Box-Muller aos pares: o uniforme u1[i] e o ângulo u2[i] dão dois normais,
+// guardados nas duas metades do vetor (acessos contíguos, vetorizável)
+void fill_normal(RngState* rng, double mean, double std_dev, double* out, int n) {
+    INSTR_START(t);
+    int pairs = n / 2;
+    double* u1 = out;
+    double* u2 = out + pairs;
+    fill_uniform(rng, out, 2 * pairs);
+    for (int i = 0; i < pairs; i++) {
+        double r = sqrt(-2.0 * fast_log(1.0 - u1[i])) * std_dev;
+        double s, c;
+        fast_sincos_2pi(u2[i], &s, &c);
+        u1[i] = r * c + mean;
+        u2[i] = r * s + mean;
+    }
+    if (n % 2)
+        out[n - 1] = rng_normal(rng, mean, std_dev);
+    INSTR_COUNT(COUNT_RNG_DRAWS, n);
+    INSTR_LAP(t, PHASE_GENERATE);
+}
+
+void fill_poisson(RngState* rng, double lambda, double* out, int n) {
+    INSTR_START(t);
+    for (int i = 0; i < n; i++)
+        out[i] = rng_poisson(rng, lambda);
+    INSTR_COUNT(COUNT_RNG_DRAWS, n);
+    INSTR_LAP(t, PHASE_GENERATE);
+}
+
+// Stream por omissão, uma por thread, para as funções sem estado explícito
+static _Thread_local RngState default_rng = { { 0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL,
+                                                0x94d049bb133111ebULL, 0x2545f4914f6cdd1dULL } };
+
+void seed_default_rng(uint64_t seed) {
+    rng_seed(&default_rng, seed);
+}
+
+void save_default_rng(RngState* out) {
+    *out = default_rng;
+}
+
+void restore_default_rng(const RngState* state) {
+    default_rng = *state;
+}
+
 double generate_exponential(double lambda) {
-    double u = ((double) rand()) / RAND_MAX;
-    return -log(1 - u) / lambda;
+    INSTR_START(t);
+    double value = rng_exponential(&default_rng, lambda);
+    INSTR_COUNT(COUNT_RNG_DRAWS, 1);
+    INSTR_LAP(t, PHASE_GENERATE);
+    return value;
 }
 
 double generate_poisson(double lambda) {
-    double L = exp(-lambda);
-    double p = 1.0;
-    int k = 0;
-    do {
-        k++;
-        p *= ((double) rand()) / RAND_MAX;
-    } while (p > L);
-    return k - 1;
+    INSTR_START(t);
+    double value = rng_poisson(&default_rng, lambda);
+    INSTR_COUNT(COUNT_RNG_DRAWS, 1);
+    INSTR_LAP(t, PHASE_GENERATE);
+    return value;
 }
 
 double generate_normal(double mean, double std_dev) {
-    double u1 = ((double) rand()) / RAND_MAX;
-    double u2 = ((double) rand()) / RAND_MAX;
-    double z = sqrt(-2.0 * log(u1)) * cos(2 * M_PI * u2);
-    return z * std_dev + mean;
+    INSTR_START(t);
+    double value = rng_normal(&default_rng, mean, std_dev);
+    INSTR_COUNT(COUNT_RNG_DRAWS, 1);
+    INSTR_LAP(t, PHASE_GENERATE);
+    return value;
 }